@@ -0,0 +1,183 @@
+/**
+ * @file bench_heaps.cpp
+ * @brief Head-to-head benchmark of kj heaps.
+ *
+ * Compares kj::SkewHeap, kj::SkewHeapArena, kj::AddressableSkewHeap, kj::PairingHeap and
+ * kj::DaryHeap / kj::IndexedDaryHeap on:
+ * - push/pop of random keys,
+ * - draining a heap to sorted output (pop loop vs SkewHeap::drain_sorted),
+ * - melding many small heaps into one,
+ * - Dijkstra on a random sparse graph (decrease_key where available, lazy deletion otherwise).
+ */
+
+#include <kj/benchmark.hpp>
+#include <kj/buffer.hpp>
+#include <kj/skew_heap.hpp>
+#include <kj/addressable_skew_heap.hpp>
+#include <kj/pairing_heap.hpp>
+#include <kj/dary_heap.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	using Graph = std::vector<std::vector<std::pair<int, int>>>;
+
+	template <class Heap>
+	long long push_pop(const std::vector<int>& keys) {
+		Heap h;
+		for (int k : keys) h.push(k);
+		long long sum = 0;
+		while (!h.empty()) { sum += h.top(); h.pop(); }
+		return sum;
+	}
+
+	template <class Heap>
+	long long meld_many(const std::vector<int>& keys, std::size_t per_heap) {
+		std::vector<Heap> heaps(keys.size() / per_heap);
+		for (std::size_t i = 0; i < heaps.size() * per_heap; ++i) heaps[i / per_heap].push(keys[i]);
+		for (std::size_t i = 1; i < heaps.size(); ++i) heaps[0].merge(heaps[i]);
+		return heaps[0].top();
+	}
+
+	// Same-pool variant for heaps that support pool sharing.
+	template <class Heap>
+	long long meld_many_shared(const std::vector<int>& keys, std::size_t per_heap) {
+		typename Heap::pool_type pool;
+		long long top = 0;
+		{
+			std::vector<Heap> heaps;
+			heaps.reserve(keys.size() / per_heap);
+			for (std::size_t i = 0; i < keys.size() / per_heap; ++i) heaps.emplace_back(pool);
+			for (std::size_t i = 0; i < heaps.size() * per_heap; ++i) heaps[i / per_heap].push(keys[i]);
+			for (std::size_t i = 1; i < heaps.size(); ++i) heaps[0].merge(heaps[i]);
+			top = heaps[0].top();
+		}
+		return top;
+	}
+
+	template <class Heap>
+	long long dijkstra_lazy(const Graph& g) {
+		using P = std::pair<long long, int>;
+		std::vector<long long> dist(g.size(), -1);
+		Heap h;
+		h.push(P{ 0, 0 });
+		while (!h.empty()) {
+			auto [d, u] = h.top(); h.pop();
+			if (dist[u] >= 0) continue;
+			dist[u] = d;
+			for (auto [v, w] : g[u]) if (dist[v] < 0) h.push(P{ d + w, v });
+		}
+		long long s = 0;
+		for (auto d : dist) s += d;
+		return s;
+	}
+
+	template <class Heap>
+	long long dijkstra_decrease(const Graph& g) {
+		using P = std::pair<long long, int>;
+		std::vector<long long> dist(g.size(), -1);
+		std::vector<typename Heap::handle> where(g.size());
+		std::vector<char> done(g.size(), 0);
+		Heap h;
+		dist[0] = 0;
+		where[0] = h.push(P{ 0, 0 });
+		while (!h.empty()) {
+			auto [d, u] = h.top(); h.pop();
+			done[u] = 1;
+			for (auto [v, w] : g[u]) {
+				if (done[v]) continue;
+				if (dist[v] < 0) { dist[v] = d + w; where[v] = h.push(P{ dist[v], v }); }
+				else if (d + w < dist[v]) { dist[v] = d + w; h.decrease_key(where[v], P{ dist[v], v }); }
+			}
+		}
+		long long s = 0;
+		for (auto d : dist) s += d;
+		return s;
+	}
+
+	// Id-based decrease_key on an indexed array heap (node id == vertex).
+	template <class Heap>
+	long long dijkstra_indexed(const Graph& g) {
+		std::vector<long long> dist(g.size(), -1);
+		std::vector<char> done(g.size(), 0);
+		Heap h;
+		dist[0] = 0;
+		h.push(0, 0);
+		while (!h.empty()) {
+			const long long d = h.top();
+			const int u = h.top_id();
+			h.pop();
+			done[u] = 1;
+			for (auto [v, w] : g[u]) {
+				if (done[v]) continue;
+				if (dist[v] < 0) { dist[v] = d + w; h.push(v, dist[v]); }
+				else if (d + w < dist[v]) { dist[v] = d + w; h.decrease_key(v, dist[v]); }
+			}
+		}
+		long long s = 0;
+		for (auto d : dist) s += d;
+		return s;
+	}
+
+} // namespace
+
+int main() {
+	kj::Benchmark bench("heaps", 1, 5);
+	std::mt19937 rng(2024);
+	long long sink = 0;
+
+	std::vector<int> keys(1 << 20);
+	for (auto& k : keys) k = static_cast<int>(rng() >> 1);
+
+	bench.run("push/pop 1M  SkewHeap", [&] { sink += push_pop<kj::SkewHeap<int>>(keys); });
+	bench.run("push/pop 1M  SkewHeapArena", [&] { sink += push_pop<kj::SkewHeapArena<int>>(keys); });
+	bench.run("push/pop 1M  AddressableSkewHeap", [&] { sink += push_pop<kj::AddressableSkewHeap<int>>(keys); });
+	bench.run("push/pop 1M  PairingHeap", [&] { sink += push_pop<kj::PairingHeap<int>>(keys); });
+	bench.run("push/pop 1M  DaryHeap<4>", [&] { sink += push_pop<kj::DaryHeap<int, std::less<int>, 4>>(keys); });
+	bench.run("push/pop 1M  DaryHeap<8>", [&] { sink += push_pop<kj::DaryHeap<int, std::less<int>, 8>>(keys); });
+	bench.run("push/pop 1M  DaryHeap<16>", [&] { sink += push_pop<kj::DaryHeap<int, std::less<int>, 16>>(keys); });
+	bench.run("heapify 1M  DaryHeap<8>", [&] {
+		kj::DaryHeap<int> h(keys.begin(), keys.end());
+		sink += h.top();
+	});
+
+	bench.run("drain 1M  SkewHeapArena top/pop loop", [&] {
+		kj::SkewHeapArena<int> h(keys.begin(), keys.end());
+		std::vector<int> out;
+		out.reserve(keys.size());
+		while (!h.empty()) { out.push_back(h.top()); h.pop(); }
+		sink += out.back();
+	});
+	bench.run("drain 1M  SkewHeapArena drain_sorted", [&] {
+		kj::SkewHeapArena<int> h(keys.begin(), keys.end());
+		kj::Buffer<int> out(keys.size());
+		sink += static_cast<long long>(h.drain_sorted(out));
+	});
+
+	bench.run("meld 64k x 16  SkewHeap", [&] { sink += meld_many<kj::SkewHeap<int>>(keys, 16); });
+	bench.run("meld 64k x 16  SkewHeapArena (shared pool)", [&] { sink += meld_many_shared<kj::SkewHeapArena<int>>(keys, 16); });
+	bench.run("meld 64k x 16  PairingHeap (shared pool)", [&] { sink += meld_many_shared<kj::PairingHeap<int>>(keys, 16); });
+
+	const int n = 1 << 18;
+	Graph g(n);
+	for (int u = 0; u < n; ++u) {
+		g[u].emplace_back((u + 1) % n, 1 + static_cast<int>(rng() % 1000));   // keep it connected
+		for (int e = 0; e < 7; ++e) g[u].emplace_back(static_cast<int>(rng() % n), 1 + static_cast<int>(rng() % 1000));
+	}
+
+	using P = std::pair<long long, int>;
+	bench.run("dijkstra 256k/2M  SkewHeap (lazy)", [&] { sink += dijkstra_lazy<kj::SkewHeap<P>>(g); });
+	bench.run("dijkstra 256k/2M  AddressableSkewHeap (decrease_key)", [&] { sink += dijkstra_decrease<kj::AddressableSkewHeap<P>>(g); });
+	bench.run("dijkstra 256k/2M  PairingHeap (decrease_key)", [&] { sink += dijkstra_decrease<kj::PairingHeap<P>>(g); });
+	bench.run("dijkstra 256k/2M  IndexedDaryHeap<8> (decrease_key)", [&] { sink += dijkstra_indexed<kj::IndexedDaryHeap<long long>>(g); });
+
+	std::printf("checksum %lld\n", sink);
+	return 0;
+}
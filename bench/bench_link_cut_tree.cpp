@@ -0,0 +1,83 @@
+/**
+ * @file bench_link_cut_tree.cpp
+ * @brief Link-cut tree throughput on random forests.
+ *
+ * Each run starts from a random recursive forest (vertex i links to a random
+ * earlier vertex with probability 3/4) and performs 3M operations: a third cut
+ * a random existing edge, a third link a random pair (failing if already
+ * connected), and a third ask connected() for a random pair.
+ */
+
+#include <kj/benchmark.hpp>
+#include <kj/link_cut_tree.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	constexpr int ops = 3'000'000;
+
+	// xorshift64*: keeps the driver's own cost small next to the tree operations
+	struct Rng {
+		std::uint64_t s;
+		std::uint32_t below(std::uint64_t n) noexcept {
+			s ^= s >> 12; s ^= s << 25; s ^= s >> 27;
+			return static_cast<std::uint32_t>(((s * 0x2545F4914F6CDD1Dull) >> 32) * n >> 32);
+		}
+	};
+
+	template <class Tree>
+	std::uint64_t run_forest(int n, std::uint64_t seed) {
+		Rng rng{ seed };
+		Tree t(n);
+		std::vector<std::pair<int, int>> edges;
+		for (int i = 1; i < n; ++i) {
+			if (rng.below(4) == 0) continue;
+			const int p = static_cast<int>(rng.below(static_cast<std::uint64_t>(i)));
+			t.link(i, p);
+			edges.emplace_back(i, p);
+		}
+		std::uint64_t hits = 0;
+		for (int k = 0; k < ops; ++k) {
+			const int u = static_cast<int>(rng.below(static_cast<std::uint64_t>(n)));
+			const int v = static_cast<int>(rng.below(static_cast<std::uint64_t>(n)));
+			switch (k % 3) {
+			case 0:
+				if (!edges.empty()) {
+					const std::size_t e = rng.below(edges.size());
+					hits += t.cut(edges[e].first, edges[e].second);
+					edges[e] = edges.back();
+					edges.pop_back();
+				}
+				break;
+			case 1:
+				if (t.link(u, v)) { edges.emplace_back(u, v); ++hits; }
+				break;
+			default:
+				hits += t.connected(u, v);
+				break;
+			}
+		}
+		return hits;
+	}
+
+} // namespace
+
+int main() {
+	kj::Benchmark bench("link-cut tree, 3M mixed ops", 1, 3);
+	std::uint64_t sink = 0;
+
+	for (int n : { 1'000, 10'000, 100'000, 1'000'000 }) {
+		char label[64];
+		std::snprintf(label, sizeof label, "LinkCutTree<> n=%d", n);
+		bench.run(label, [&] { sink += run_forest<kj::LinkCutTree<>>(n, 0x9E3779B97F4A7C15ull); });
+		std::snprintf(label, sizeof label, "LinkCutTree<long long> n=%d", n);
+		bench.run(label, [&] { sink += run_forest<kj::LinkCutTree<long long>>(n, 0x9E3779B97F4A7C15ull); });
+	}
+
+	std::printf("checksum %llu\n", static_cast<unsigned long long>(sink));
+	return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file bench_multi_queue.cpp
+ * @brief Thread scaling of kj::MultiQueue against a mutex-guarded kj::DaryHeap.
+ *
+ * Workload ("hold model", as in parallel SSSP): the queue is prefilled with 1M keys,
+ * then every thread repeatedly pops an element and pushes it back with a random
+ * increment. Throughput is reported in Mops/s for 1..64 threads. A second run drains
+ * the prefilled queue concurrently and reports the rank error of the pop sequence.
+ *
+ * Scaling numbers are only meaningful on a machine with at least as many cores as
+ * threads; on fewer cores the oversubscribed rows show lock-handoff overhead instead.
+ */
+
+#include <kj/timer.hpp>
+#include <kj/dary_heap.hpp>
+#include <kj/multi_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+	constexpr std::size_t prefill = 1 << 20;
+	constexpr std::size_t ops_total = 1 << 22;
+
+	template <class Body>
+	double run_threads(unsigned threads, Body body) {
+		std::vector<std::thread> pool;
+		kj::Timer t;
+		t.start();
+		for (unsigned i = 0; i < threads; ++i) pool.emplace_back(body, i);
+		for (auto& th : pool) th.join();
+		return t.stop();
+	}
+
+	double hold_multiqueue(unsigned threads) {
+		kj::MultiQueue<std::uint64_t> q(threads, 2);
+		{
+			auto h = q.handle(0);
+			std::mt19937_64 rng(1);
+			for (std::size_t i = 0; i < prefill; ++i) h.push(rng() >> 20);
+		}
+		const double ms = run_threads(threads, [&](unsigned id) {
+			auto h = q.handle(id + 1);
+			std::mt19937_64 rng(id + 1);
+			for (std::size_t i = 0; i < ops_total / threads; ++i) {
+				std::uint64_t v;
+				if (h.try_pop(v)) h.push(v + (rng() & 0xFFFF));
+			}
+		});
+		const auto s = q.stats();
+		std::printf("  MultiQueue    %2u threads: %7.2f Mops/s  (lock failures %.2f%%)\n", threads,
+			2.0 * static_cast<double>(ops_total) / ms / 1e3,
+			100.0 * static_cast<double>(s.lock_failures) / static_cast<double>(s.pushes + s.pops));
+		return ms;
+	}
+
+	double hold_locked(unsigned threads) {
+		kj::DaryHeap<std::uint64_t> heap;
+		std::mutex m;
+		std::mt19937_64 seed(1);
+		for (std::size_t i = 0; i < prefill; ++i) heap.push(seed() >> 20);
+		const double ms = run_threads(threads, [&](unsigned id) {
+			std::mt19937_64 rng(id + 1);
+			for (std::size_t i = 0; i < ops_total / threads; ++i) {
+				std::lock_guard<std::mutex> g(m);
+				const std::uint64_t v = heap.top();
+				heap.pop();
+				heap.push(v + (rng() & 0xFFFF));
+			}
+		});
+		std::printf("  mutex+DaryHeap %2u threads: %7.2f Mops/s\n", threads,
+			2.0 * static_cast<double>(ops_total) / ms / 1e3);
+		return ms;
+	}
+
+	void drain_rank_error(unsigned threads) {
+		kj::MultiQueue<std::uint64_t> q(threads, 2);
+		{
+			auto h = q.handle(0);
+			for (std::uint64_t i = 0; i < prefill; ++i) h.push((i * 2654435761u) % prefill);
+		}
+		std::vector<std::uint64_t> log(prefill);
+		std::atomic<std::size_t> ticket{ 0 };
+		run_threads(threads, [&](unsigned id) {
+			auto h = q.handle(id + 1);
+			for (std::uint64_t v; h.try_pop(v); ) log[ticket.fetch_add(1, std::memory_order_relaxed)] = v;
+		});
+		const auto r = kj::rank_errors<std::uint64_t>(log);
+		std::printf("  rank error    %2u threads: mean %.1f, max %zu (%zu queues)\n", threads, r.mean, r.max, q.queues());
+	}
+
+} // namespace
+
+int main() {
+	std::printf("hold model, %zu prefilled, %zu ops (hardware threads: %u)\n", prefill, ops_total,
+		std::thread::hardware_concurrency());
+	for (unsigned t : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+		hold_multiqueue(t);
+		hold_locked(t);
+	}
+	for (unsigned t : {1u, 4u, 16u, 64u}) drain_rank_error(t);
+	return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file bench_radix_heap.cpp
+ * @brief Dijkstra on a road-network-sized grid: integer queues vs comparison heaps.
+ *
+ * The graph is a 2048 x 2048 grid (4M vertices, ~16M arcs, CSR) with random
+ * integer travel times, which has the low degree and large diameter of road
+ * networks. Every queue runs lazy-deletion Dijkstra except IndexedDaryHeap,
+ * which uses decrease_key. MonotoneBucketQueue runs Dial's algorithm (weights < 4096).
+ */
+
+#include <kj/benchmark.hpp>
+#include <kj/skew_heap.hpp>
+#include <kj/dary_heap.hpp>
+#include <kj/radix_heap.hpp>
+#include <kj/bucket_queue.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	struct Csr {
+		std::vector<std::uint32_t> first;   // size n + 1
+		std::vector<std::uint32_t> head;
+		std::vector<std::uint32_t> weight;
+	};
+
+	Csr make_grid(std::uint32_t side, std::mt19937& rng) {
+		Csr g;
+		const std::uint32_t n = side * side;
+		g.first.assign(n + 1, 0);
+		g.head.reserve(std::size_t{ n } * 4);
+		g.weight.reserve(std::size_t{ n } * 4);
+		for (std::uint32_t u = 0; u < n; ++u) {
+			const std::uint32_t x = u % side, y = u / side;
+			auto arc = [&](std::uint32_t v) { g.head.push_back(v); g.weight.push_back(1 + rng() % 1000); };
+			if (x > 0) arc(u - 1);
+			if (x + 1 < side) arc(u + 1);
+			if (y > 0) arc(u - side);
+			if (y + 1 < side) arc(u + side);
+			g.first[u + 1] = static_cast<std::uint32_t>(g.head.size());
+		}
+		return g;
+	}
+
+	std::uint64_t checksum(const std::vector<std::uint64_t>& dist) {
+		std::uint64_t s = 0;
+		for (auto d : dist) s += d;
+		return s;
+	}
+
+	template <class Heap>
+	std::uint64_t dijkstra_lazy(const Csr& g) {
+		using P = std::pair<std::uint64_t, std::uint32_t>;
+		constexpr auto inf = ~std::uint64_t{ 0 };
+		std::vector<std::uint64_t> dist(g.first.size() - 1, inf);
+		Heap h;
+		dist[0] = 0;
+		h.push(P{ 0, 0 });
+		while (!h.empty()) {
+			auto [d, u] = h.top(); h.pop();
+			if (d != dist[u]) continue;
+			for (auto a = g.first[u]; a < g.first[u + 1]; ++a) {
+				const auto v = g.head[a];
+				if (d + g.weight[a] < dist[v]) { dist[v] = d + g.weight[a]; h.push(P{ dist[v], v }); }
+			}
+		}
+		return checksum(dist);
+	}
+
+	std::uint64_t dijkstra_radix(const Csr& g) {
+		constexpr auto inf = ~std::uint64_t{ 0 };
+		std::vector<std::uint64_t> dist(g.first.size() - 1, inf);
+		kj::RadixHeap<std::uint64_t, std::uint32_t> h;
+		dist[0] = 0;
+		h.push(0, 0);
+		while (!h.empty()) {
+			auto [d, u] = h.top(); h.pop();
+			if (d != dist[u]) continue;
+			for (auto a = g.first[u]; a < g.first[u + 1]; ++a) {
+				const auto v = g.head[a];
+				if (d + g.weight[a] < dist[v]) { dist[v] = d + g.weight[a]; h.push(dist[v], v); }
+			}
+		}
+		return checksum(dist);
+	}
+
+	std::uint64_t dijkstra_dial(const Csr& g) {
+		constexpr auto inf = ~std::uint64_t{ 0 };
+		std::vector<std::uint64_t> dist(g.first.size() - 1, inf);
+		kj::MonotoneBucketQueue<std::uint32_t> h;
+		dist[0] = 0;
+		h.push(0, 0);
+		while (!h.empty()) {
+			const std::uint64_t d = h.top_priority();
+			const std::uint32_t u = h.top();
+			h.pop();
+			if (d != dist[u]) continue;
+			for (auto a = g.first[u]; a < g.first[u + 1]; ++a) {
+				const auto v = g.head[a];
+				if (d + g.weight[a] < dist[v]) { dist[v] = d + g.weight[a]; h.push(dist[v], v); }
+			}
+		}
+		return checksum(dist);
+	}
+
+	std::uint64_t dijkstra_indexed(const Csr& g) {
+		constexpr auto inf = ~std::uint64_t{ 0 };
+		std::vector<std::uint64_t> dist(g.first.size() - 1, inf);
+		kj::IndexedDaryHeap<std::uint64_t> h;
+		dist[0] = 0;
+		h.push(0, 0);
+		while (!h.empty()) {
+			const auto d = h.top();
+			const auto u = static_cast<std::uint32_t>(h.top_id());
+			h.pop();
+			for (auto a = g.first[u]; a < g.first[u + 1]; ++a) {
+				const auto v = g.head[a];
+				const auto nd = d + g.weight[a];
+				if (nd >= dist[v]) continue;
+				if (dist[v] == inf) h.push(static_cast<int>(v), nd);
+				else h.decrease_key(static_cast<int>(v), nd);
+				dist[v] = nd;
+			}
+		}
+		return checksum(dist);
+	}
+
+} // namespace
+
+int main() {
+	std::mt19937 rng(7);
+	const Csr g = make_grid(2048, rng);
+
+	kj::Benchmark bench("dijkstra grid 4M/16M", 1, 3);
+	std::uint64_t sink = 0;
+	using P = std::pair<std::uint64_t, std::uint32_t>;
+
+	bench.run("SkewHeap (lazy)", [&] { sink += dijkstra_lazy<kj::SkewHeap<P>>(g); });
+	bench.run("SkewHeapArena (lazy)", [&] { sink += dijkstra_lazy<kj::SkewHeapArena<P>>(g); });
+	bench.run("DaryHeap<8> (lazy)", [&] { sink += dijkstra_lazy<kj::DaryHeap<P>>(g); });
+	bench.run("IndexedDaryHeap<8> (decrease_key)", [&] { sink += dijkstra_indexed(g); });
+	bench.run("RadixHeap (lazy)", [&] { sink += dijkstra_radix(g); });
+	bench.run("MonotoneBucketQueue (Dial)", [&] { sink += dijkstra_dial(g); });
+
+	std::printf("checksum %llu\n", static_cast<unsigned long long>(sink));
+	return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file bench_skew_heap_merge.cpp
+ * @brief Benchmark: iterative (kj::detail::skew_merge) vs recursive skew heap merge.
+ *
+ * Two workloads on a preallocated node array:
+ * - random:      push N random keys one by one, then pop all (merge on every step),
+ * - adversarial: merge two interleaved right spines of length N (longest merge path).
+ *
+ * The recursive merge uses one frame per node of the merged spines, so its adversarial
+ * case is kept at 2x2k: a few thousand frames fit the smallest default stack in the CI
+ * matrix (1 MB on Windows). The large case runs iteratively only.
+ */
+
+#include <kj/benchmark.hpp>
+#include <kj/skew_heap.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+	struct Node {
+		int   key;
+		Node* left;
+		Node* right;
+	};
+
+	using Merge = Node* (*)(Node*, Node*, std::less<int>&);
+
+	Node* merge_iter(Node* a, Node* b, std::less<int>& c) { return kj::detail::skew_merge(a, b, c); }
+	Node* merge_rec(Node* a, Node* b, std::less<int>& c) { return kj::detail::skew_merge_recursive(a, b, c); }
+
+	long long push_pop_all(std::vector<Node>& nodes, const std::vector<int>& keys, Merge merge) {
+		std::less<int> cmp;
+		Node* root = nullptr;
+		for (std::size_t i = 0; i < keys.size(); ++i) {
+			nodes[i] = Node{ keys[i], nullptr, nullptr };
+			root = merge(root, &nodes[i], cmp);
+		}
+		long long sum = 0;
+		while (root) {
+			sum += root->key;
+			root = merge(root->left, root->right, cmp);
+		}
+		return sum;
+	}
+
+	int merge_spines(std::vector<Node>& nodes, Merge merge) {
+		std::less<int> cmp;
+		const std::size_t n = nodes.size() / 2;
+		// spine A: 0, 2, 4, ...   spine B: 1, 3, 5, ...  (right children only)
+		for (std::size_t i = 0; i < nodes.size(); ++i) {
+			nodes[i] = Node{ static_cast<int>(i), nullptr, i + 2 < nodes.size() ? &nodes[i + 2] : nullptr };
+		}
+		Node* r = merge(&nodes[0], &nodes[1], cmp);
+		return r->key + static_cast<int>(n);
+	}
+
+} // namespace
+
+int main() {
+	kj::Benchmark bench("skew_heap_merge", 2, 5);
+
+	const std::size_t n_random = 1 << 20;
+	std::vector<int> keys(n_random);
+	std::mt19937 rng(12345);
+	for (auto& k : keys) k = static_cast<int>(rng());
+	std::vector<Node> nodes(n_random);
+
+	long long sink = 0;
+	bench.run("random push/pop 1M, iterative", [&] { sink += push_pop_all(nodes, keys, merge_iter); });
+	bench.run("random push/pop 1M, recursive", [&] { sink += push_pop_all(nodes, keys, merge_rec); });
+
+	std::vector<Node> spine(2 * 2000);
+	bench.run("adversarial spines 2x2k, iterative", [&] { sink += merge_spines(spine, merge_iter); });
+	bench.run("adversarial spines 2x2k, recursive", [&] { sink += merge_spines(spine, merge_rec); });
+
+	std::vector<Node> big(2 * 5000000);
+	bench.run("adversarial spines 2x5M, iterative (recursive would overflow)", [&] { sink += merge_spines(big, merge_iter); });
+
+	std::printf("checksum %lld\n", sink);
+	return 0;
+}
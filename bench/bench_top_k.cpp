@@ -0,0 +1,62 @@
+/**
+ * @file bench_top_k.cpp
+ * @brief Streaming top-k: kj::TopK strategies against a SkewHeap push/pop loop.
+ *
+ * Keeps the 1000 largest of 2^26 random float scores.
+ */
+
+#include <kj/benchmark.hpp>
+#include <kj/skew_heap.hpp>
+#include <kj/top_k.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+	constexpr std::size_t k = 1000;
+
+	template <kj::TopKStrategy S>
+	float top_k_single(const std::vector<float>& v) {
+		kj::TopK<float, std::greater<float>, S> t(k);
+		for (float x : v) t.push(x);
+		return t.take_sorted().back();
+	}
+
+	template <kj::TopKStrategy S>
+	float top_k_batch(const std::vector<float>& v) {
+		kj::TopK<float, std::greater<float>, S> t(k);
+		t.push_batch(v);
+		return t.take_sorted().back();
+	}
+
+	float skew_heap_loop(const std::vector<float>& v) {
+		kj::SkewHeapArena<float> h;   // min-heap of the kept largest
+		for (float x : v) {
+			h.push(x);
+			if (h.size() > k) h.pop();
+		}
+		return h.top();
+	}
+
+} // namespace
+
+int main() {
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+	std::vector<float> v(std::size_t{ 1 } << 26);
+	for (auto& x : v) x = dist(rng);
+
+	kj::Benchmark bench("top-1000 of 64M floats", 1, 3);
+	float sink = 0;
+	bench.run("SkewHeapArena push + pop", [&] { sink += skew_heap_loop(v); });
+	bench.run("TopK heap, push", [&] { sink += top_k_single<kj::TopKStrategy::heap>(v); });
+	bench.run("TopK heap, push_batch", [&] { sink += top_k_batch<kj::TopKStrategy::heap>(v); });
+	bench.run("TopK buffer, push", [&] { sink += top_k_single<kj::TopKStrategy::buffer>(v); });
+	bench.run("TopK buffer, push_batch", [&] { sink += top_k_batch<kj::TopKStrategy::buffer>(v); });
+	std::printf("checksum %f\n", static_cast<double>(sink));
+	return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <functional>
+#include <kj/detail/addressable_skew_heap_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the addressable skew heap (handles, decrease_key, erase).
+	 *
+	 * @see kj::detail::AddressableSkewHeap
+	 */
+	template<class T, class Comp = std::less<T>>
+	using AddressableSkewHeap = ::kj::detail::AddressableSkewHeap<T, Comp>;
+
+} // namespace kj
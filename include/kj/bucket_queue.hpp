@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <kj/detail/bucket_queue_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the bucket queue over priorities [0, N) (default 0..4095).
+	 *
+	 * @see kj::detail::BucketQueue
+	 */
+	template<class Value, std::size_t N = 4096>
+	using BucketQueue = ::kj::detail::BucketQueue<Value, N, /*Monotone=*/false>;
+
+	/**
+	 * @brief Public alias for the cyclic bucket queue for Dial's algorithm.
+	 *
+	 * Live priorities must stay within a window of N above the current minimum,
+	 * e.g. N greater than the largest edge weight.
+	 */
+	template<class Value, std::size_t N = 4096>
+	using MonotoneBucketQueue = ::kj::detail::BucketQueue<Value, N, /*Monotone=*/true>;
+
+} // namespace kj
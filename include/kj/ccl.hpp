@@ -0,0 +1,59 @@
+#pragma once
+#include <span>
+#include <ranges>
+#include <cstdint>
+#include <type_traits>
+#include <kj/buffer.hpp>
+#include <kj/detail/ccl_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the pixel adjacency used by connected-component labeling.
+	 *
+	 * @see kj::detail::Connectivity
+	 */
+	using Connectivity = ::kj::detail::Connectivity;
+
+	using ::kj::detail::label_components;
+	using ::kj::detail::label_components_bits;
+
+	/**
+	 * @brief Labels a @p width x @p height grid held in a kj::Buffer.
+	 *
+	 * @see kj::detail::label_components
+	 */
+	template <class P>
+	int label_components(const Buffer<P>& pixels, int width, int height, Buffer<int>& labels,
+		Connectivity conn = Connectivity::four, unsigned threads = 1) {
+		return ::kj::detail::label_components(pixels.span(), width, height, labels.span(), conn, threads);
+	}
+
+	/**
+	 * @brief Labels a grid held in any contiguous range, e.g. a std::vector.
+	 *
+	 * The std::span overload cannot deduce its pixel type from a container, so
+	 * @c label_components(vec, w, h, labels) lands here; @p labels converts to std::span<int>.
+	 *
+	 * @see kj::detail::label_components
+	 */
+	template <std::ranges::contiguous_range R>
+		requires std::ranges::sized_range<const R&>
+	int label_components(const R& pixels, int width, int height, std::span<int> labels,
+		Connectivity conn = Connectivity::four, unsigned threads = 1) {
+		using P = std::remove_cv_t<std::ranges::range_value_t<R>>;
+		return ::kj::detail::label_components(std::span<const P>(std::ranges::data(pixels), std::ranges::size(pixels)),
+			width, height, labels, conn, threads);
+	}
+
+	/**
+	 * @brief Labels a packed bit grid held in a kj::Buffer.
+	 *
+	 * @see kj::detail::label_components_bits
+	 */
+	inline int label_components_bits(const Buffer<std::uint64_t>& bits, int width, int height, Buffer<int>& labels,
+		Connectivity conn = Connectivity::four, unsigned threads = 1) {
+		return ::kj::detail::label_components_bits(bits.span(), width, height, labels.span(), conn, threads);
+	}
+
+} // namespace kj
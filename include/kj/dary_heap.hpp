@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <kj/detail/dary_heap_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the cache-friendly D-ary array heap (min-heap by default).
+	 *
+	 * Prefer this over kj::SkewHeap when heaps are never melded.
+	 *
+	 * @see kj::detail::DaryHeap
+	 */
+	template<class T, class Comp = std::less<T>, std::size_t D = 8>
+	using DaryHeap = ::kj::detail::DaryHeap<T, Comp, D, /*Indexed=*/false>;
+
+	/**
+	 * @brief Public alias for the D-ary heap with an id -> position map (decrease_key by id).
+	 */
+	template<class T, class Comp = std::less<T>, std::size_t D = 8>
+	using IndexedDaryHeap = ::kj::detail::DaryHeap<T, Comp, D, /*Indexed=*/true>;
+
+} // namespace kj
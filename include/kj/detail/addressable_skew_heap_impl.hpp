@@ -0,0 +1,267 @@
+#pragma once
+#include <utility>
+#include <cstddef>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <kj/detail/object_pool.hpp>
+#include <kj/detail/skew_heap_impl.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Pool-backed skew heap with parent links and stable handles.
+	 *
+	 * Same interface as @ref SkewHeap, except that @ref push / @ref emplace return a
+	 * @ref handle that stays valid until its element is popped or erased. Handles allow
+	 * @ref decrease_key (cut the subtree and meld it back at the root) and @ref erase
+	 * (splice the merged children into the parent), both O(log n) amortized.
+	 *
+	 * Nodes come from an @ref ObjectPool that is either owned (created on first use) or
+	 * shared by reference between heaps, as in @ref SkewHeap with @c UsePool.
+	 *
+	 * @tparam T    Key type.
+	 * @tparam Comp Comparator (StrictWeakOrder), defaults to @c std::less<T> (min-heap).
+	 */
+	template <class T, class Comp = std::less<T>>
+	class AddressableSkewHeap {
+	private:
+		/**
+		 * @brief Internal node type.
+		 */
+		struct Node {
+			T     key;
+			Node* left;
+			Node* right;
+			Node* parent;
+
+			template<class U>
+			explicit Node(U&& v) : key(std::forward<U>(v)), left(nullptr), right(nullptr), parent(nullptr) {}
+		};
+
+		Node* root_ = nullptr;
+		std::size_t sz_ = 0;
+		[[no_unique_address]] Comp cmp_{};
+		ObjectPool<Node>* pool_ = nullptr;
+		std::unique_ptr<ObjectPool<Node>> own_;
+
+		ObjectPool<Node>& pool_ref() {
+			if (!pool_) {
+				own_ = std::make_unique<ObjectPool<Node>>();
+				pool_ = own_.get();
+			}
+			return *pool_;
+		}
+
+		// Shared top-down skew merge that also maintains parent links.
+		Node* merge_nodes(Node* a, Node* b) {
+			Node* root = skew_merge(a, b, cmp_, skew_no_push{}, [](Node* p, Node* c) noexcept { c->parent = p; });
+			if (root) root->parent = nullptr;
+			return root;
+		}
+
+		// Replaces node x (non-root) by subtree s in x's parent.
+		void replace_in_parent(Node* x, Node* s) noexcept {
+			Node* p = x->parent;
+			(p->left == x ? p->left : p->right) = s;
+			if (s) s->parent = p;
+			x->parent = nullptr;
+		}
+
+		void destroy_all() noexcept {
+			// Same stack-free teardown as SkewHeap::destroy_iter.
+			Node* n = root_;
+			while (n) {
+				if (Node* l = n->left) {
+					n->left = l->right;
+					l->right = n;
+					n = l;
+				}
+				else {
+					Node* next = n->right;
+					pool_->destroy(n);
+					n = next;
+				}
+			}
+		}
+
+	public:
+		/// Node pool type usable for sharing one pool between heaps.
+		using pool_type = ObjectPool<Node>;
+
+		/**
+		 * @brief Stable reference to an element (valid until popped or erased).
+		 */
+		class handle {
+		public:
+			handle() = default;
+			explicit operator bool() const noexcept { return n_ != nullptr; }
+			friend bool operator==(handle a, handle b) noexcept { return a.n_ == b.n_; }
+			friend bool operator!=(handle a, handle b) noexcept { return a.n_ != b.n_; }
+
+		private:
+			friend class AddressableSkewHeap;
+			explicit handle(Node* n) noexcept : n_(n) {}
+			Node* n_ = nullptr;
+		};
+
+		//-------------------------------------------------------------------------
+		// Construction / destruction
+		//-------------------------------------------------------------------------
+
+		/// Constructs an empty heap; an own pool is created on first use.
+		AddressableSkewHeap() = default;
+
+		/// Constructs an empty heap with a custom comparator.
+		explicit AddressableSkewHeap(const Comp& c) : cmp_(c) {}
+
+		/// Constructs an empty heap allocating from the shared @p pool (must outlive the heap).
+		explicit AddressableSkewHeap(pool_type& pool, const Comp& c = Comp{}) : cmp_(c), pool_(&pool) {}
+
+		~AddressableSkewHeap() { clear(); }
+
+		AddressableSkewHeap(const AddressableSkewHeap&) = delete;
+		AddressableSkewHeap& operator=(const AddressableSkewHeap&) = delete;
+
+		// Moving keeps handles valid: nodes stay in the same (heap-allocated or shared) pool.
+		// Move assignment hands the target's previous pool binding to the source, so an
+		// owned pool other heaps may still be bound to (see @ref pool) is never destroyed.
+		AddressableSkewHeap(AddressableSkewHeap&& other) noexcept
+			: root_(other.root_), sz_(other.sz_), cmp_(std::move(other.cmp_)),
+			pool_(other.pool_), own_(std::move(other.own_)) {
+			other.root_ = nullptr; other.sz_ = 0; other.pool_ = nullptr;
+		}
+		AddressableSkewHeap& operator=(AddressableSkewHeap&& other) noexcept {
+			if (this != &other) {
+				clear();
+				root_ = other.root_; sz_ = other.sz_;
+				cmp_ = std::move(other.cmp_);
+				using std::swap;
+				swap(pool_, other.pool_);
+				swap(own_, other.own_);
+				other.root_ = nullptr; other.sz_ = 0;
+			}
+			return *this;
+		}
+
+		/// Exchanges contents (and pool bindings) with @p other in O(1).
+		void swap(AddressableSkewHeap& other) noexcept {
+			using std::swap;
+			swap(root_, other.root_);
+			swap(sz_, other.sz_);
+			swap(cmp_, other.cmp_);
+			swap(pool_, other.pool_);
+			swap(own_, other.own_);
+		}
+
+		friend void swap(AddressableSkewHeap& a, AddressableSkewHeap& b) noexcept { a.swap(b); }
+
+		//-------------------------------------------------------------------------
+		// Pool controls
+		//-------------------------------------------------------------------------
+
+		/// Pre-allocates approximately @p n node slots in the pool in use.
+		void reserve_nodes(std::size_t n) { pool_ref().reserve(n); }
+
+		/**
+		 * @brief Returns the pool in use, e.g. to bind more heaps to it.
+		 *
+		 * Heaps bound to another heap's own pool must be destroyed before that heap (or,
+		 * after a move assignment into it, before the moved-from source that now owns it).
+		 */
+		pool_type& pool() { return pool_ref(); }
+
+		//-------------------------------------------------------------------------
+		// Observers
+		//-------------------------------------------------------------------------
+
+		/// Removes all elements (O(n), stack-free). All handles become invalid.
+		void clear() noexcept {
+			if (root_) destroy_all();
+			root_ = nullptr; sz_ = 0;
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return root_ == nullptr; }
+		[[nodiscard]] std::size_t size() const noexcept { return sz_; }
+		[[nodiscard]] const T& top() const noexcept { return root_->key; }
+		[[nodiscard]] handle top_handle() const noexcept { return handle(root_); }
+		[[nodiscard]] const Comp& comparator() const noexcept { return cmp_; }
+
+		/// Returns the key referenced by @p h.
+		[[nodiscard]] const T& value(handle h) const noexcept { return h.n_->key; }
+
+		//-------------------------------------------------------------------------
+		// Modifiers
+		//-------------------------------------------------------------------------
+
+		handle push(const T& v) { return emplace(v); }
+		handle push(T&& v) { return emplace(std::move(v)); }
+
+		template<class... Args>
+		handle emplace(Args&&... args) {
+			Node* n = pool_ref().create(T(std::forward<Args>(args)...));
+			root_ = merge_nodes(root_, n);
+			++sz_;
+			return handle(n);
+		}
+
+		void pop() { erase(handle(root_)); }
+
+		/**
+		 * @brief Replaces the key of @p h by @p v, which must not compare worse than the old key.
+		 *
+		 * The subtree of @p h stays heap-ordered, so it is cut off and melded with the root.
+		 */
+		void decrease_key(handle h, T v) {
+			Node* x = h.n_;
+			assert(!cmp_(x->key, v) && "decrease_key(): new key is worse than the old one");
+			x->key = std::move(v);
+			if (x == root_) return;
+			replace_in_parent(x, nullptr);
+			root_ = merge_nodes(root_, x);
+		}
+
+		/**
+		 * @brief Removes the element referenced by @p h; @p h becomes invalid.
+		 *
+		 * The merged children of @p h take its place under its parent (they are not better
+		 * than the parent, so heap order holds).
+		 */
+		void erase(handle h) {
+			Node* x = h.n_;
+			Node* m = merge_nodes(x->left, x->right);
+			if (x == root_) {
+				root_ = m;
+				if (m) m->parent = nullptr;
+			}
+			else {
+				replace_in_parent(x, m);
+			}
+			pool_->destroy(x);
+			--sz_;
+		}
+
+		/**
+		 * @brief Moves all elements of @p other into this heap; @p other becomes empty.
+		 *
+		 * When both heaps share a pool the trees are linked and handles of @p other stay
+		 * valid (now referring into this heap). Otherwise the elements are moved over one by
+		 * one and the handles of @p other are invalidated.
+		 */
+		void merge(AddressableSkewHeap& other) {
+			if (this == &other || !other.root_) return;
+			if (&pool_ref() != other.pool_) {
+				while (!other.empty()) {
+					push(std::move(other.root_->key));
+					other.pop();
+				}
+				return;
+			}
+			root_ = merge_nodes(root_, other.root_);
+			sz_ += other.sz_;
+			other.root_ = nullptr;
+			other.sz_ = 0;
+		}
+	};
+
+} // namespace kj::detail
@@ -0,0 +1,239 @@
+#pragma once
+#include <bit>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <type_traits>
+#include <vector>
+#include <kj/detail/buffer_vector.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Hierarchical bitmap over @p N bits with 64-ary summary levels.
+	 *
+	 * Level 0 has one bit per position; bit @c i of level @c l+1 is set iff word @c i of
+	 * level @c l is non-zero. Finding the next set bit walks up at most to the first
+	 * non-empty summary word and back down, i.e. O(log64 N) word operations.
+	 */
+	template <std::size_t N>
+	class BitTree64 {
+		static_assert(N >= 64 && N % 64 == 0, "BitTree64: N must be a positive multiple of 64");
+
+		static constexpr std::size_t words_at(std::size_t l) noexcept {
+			std::size_t w = N / 64;
+			for (; l > 0; --l) w = (w + 63) / 64;
+			return w;
+		}
+		static constexpr std::size_t count_levels() noexcept {
+			std::size_t l = 1;
+			while (words_at(l - 1) > 1) ++l;
+			return l;
+		}
+
+	public:
+		static constexpr std::size_t levels = count_levels();
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	private:
+		static constexpr std::array<std::size_t, levels + 1> offsets_ = [] {
+			std::array<std::size_t, levels + 1> o{};
+			for (std::size_t l = 0; l < levels; ++l) o[l + 1] = o[l] + words_at(l);
+			return o;
+		}();
+
+		std::array<std::uint64_t, offsets_[levels]> w_{};
+
+		std::uint64_t& word(std::size_t l, std::size_t i) noexcept { return w_[offsets_[l] + i]; }
+		std::uint64_t word(std::size_t l, std::size_t i) const noexcept { return w_[offsets_[l] + i]; }
+
+		// From a set bit @p b of level @p l down to the first set bit of level 0 below it.
+		std::size_t descend(std::size_t l, std::size_t b) const noexcept {
+			while (l > 0) {
+				--l;
+				b = b * 64 + static_cast<std::size_t>(std::countr_zero(word(l, b)));
+			}
+			return b;
+		}
+
+		std::size_t next_at(std::size_t l, std::size_t pos) const noexcept {
+			const std::size_t wi = pos >> 6;
+			if (wi >= words_at(l)) return npos;
+			const std::uint64_t w = word(l, wi) & (~std::uint64_t{ 0 } << (pos & 63));
+			if (w) return descend(l, wi * 64 + static_cast<std::size_t>(std::countr_zero(w)));
+			if (l + 1 == levels) return npos;
+			return next_at(l + 1, wi + 1);   // next non-empty word of level l, resolved to level 0
+		}
+
+	public:
+		void set(std::size_t i) noexcept {
+			for (std::size_t l = 0; l < levels; ++l, i >>= 6) {
+				std::uint64_t& w = word(l, i >> 6);
+				const std::uint64_t bit = std::uint64_t{ 1 } << (i & 63);
+				if (w & bit) return;   // summaries above are already set
+				w |= bit;
+			}
+		}
+
+		void reset(std::size_t i) noexcept {
+			for (std::size_t l = 0; l < levels; ++l, i >>= 6) {
+				std::uint64_t& w = word(l, i >> 6);
+				w &= ~(std::uint64_t{ 1 } << (i & 63));
+				if (w) return;   // word still non-empty: summaries unchanged
+			}
+		}
+
+		[[nodiscard]] bool test(std::size_t i) const noexcept { return (word(0, i >> 6) >> (i & 63)) & 1; }
+		[[nodiscard]] bool none() const noexcept { return word(levels - 1, 0) == 0; }
+
+		/// @return Smallest set position >= @p pos, or @ref npos.
+		[[nodiscard]] std::size_t next(std::size_t pos) const noexcept {
+			if (pos >= N) return npos;
+			return next_at(0, pos);
+		}
+
+		/// @return Smallest set position, or @ref npos.
+		[[nodiscard]] std::size_t first() const noexcept {
+			const std::uint64_t top = word(levels - 1, 0);
+			return top ? descend(levels - 1, static_cast<std::size_t>(std::countr_zero(top))) : npos;
+		}
+
+		void clear() noexcept { w_.fill(0); }
+	};
+
+	/**
+	 * @brief Bucket queue for small integer priorities (min first).
+	 *
+	 * One bucket per priority in [0, @p N), plus a 64-ary @ref BitTree64 of non-empty
+	 * buckets; push is O(1) and pop/top find the next bucket in O(log64 N) word operations
+	 * (two levels for the default N = 4096). Elements of equal priority come out LIFO.
+	 * Buckets are kj::Buffer-backed and keep their storage when emptied or cleared; the
+	 * bucket table itself is one heap allocation made on the first push, so the queue
+	 * object stays small and moves in O(1).
+	 *
+	 * With @p Monotone = true (Dial's algorithm) priorities are unbounded 64-bit values,
+	 * but every pushed priority must lie in [last, last + N), where @c last is the current
+	 * minimum (@ref top_priority); buckets are used cyclically. A push into an empty queue
+	 * outside the current window re-anchors the window at its priority, so a run may
+	 * start at any distance.
+	 *
+	 * @tparam Value    Stored payload.
+	 * @tparam N        Number of buckets (multiple of 64, default 4096).
+	 * @tparam Monotone If true, use a cyclic window of N priorities (default: false).
+	 */
+	template <class Value, std::size_t N = 4096, bool Monotone = false>
+	class BucketQueue {
+	public:
+		using priority_type = std::conditional_t<Monotone, std::uint64_t, std::uint32_t>;
+
+	private:
+		std::vector<BufferVector<Value>> buckets_;   // N buckets once allocated
+		BitTree64<N> bits_;
+		std::size_t n_ = 0;
+		// Non-monotone: lower bound of the minimum bucket. Monotone: current minimum
+		// (absolute). Refined by top(), which is logically const.
+		mutable priority_type cur_ = 0;
+
+		// Bucket of the minimum element; also advances cur_. Requires n_ > 0.
+		std::size_t min_bucket() const noexcept {
+			if constexpr (Monotone) {
+				const std::size_t start = static_cast<std::size_t>(cur_ % N);
+				std::size_t b = bits_.next(start);
+				if (b == BitTree64<N>::npos) {
+					b = bits_.first();
+					cur_ += static_cast<priority_type>(N - start + b);
+				}
+				else cur_ += static_cast<priority_type>(b - start);
+				return b;
+			}
+			else {
+				const std::size_t b = bits_.next(cur_);
+				cur_ = static_cast<priority_type>(b);
+				return b;
+			}
+		}
+
+	public:
+		BucketQueue() = default;
+		BucketQueue(const BucketQueue&) = delete;
+		BucketQueue& operator=(const BucketQueue&) = delete;
+
+		// Moving takes over the bucket table; the source is left empty (window at 0).
+		BucketQueue(BucketQueue&& o) noexcept
+			: buckets_(std::move(o.buckets_)), bits_(o.bits_), n_(o.n_), cur_(o.cur_) {
+			o.bits_.clear(); o.n_ = 0; o.cur_ = 0;
+		}
+		BucketQueue& operator=(BucketQueue&& o) noexcept {
+			if (this != &o) {
+				buckets_ = std::move(o.buckets_);
+				bits_ = o.bits_; n_ = o.n_; cur_ = o.cur_;
+				o.bits_.clear(); o.n_ = 0; o.cur_ = 0;
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Inserts @p value with priority @p p in O(1).
+		 * @pre p < N, or with @p Monotone: top_priority() <= p < top_priority() + N
+		 *      (any p if the queue is empty).
+		 */
+		template <class... Args>
+		void emplace(priority_type p, Args&&... args) {
+			std::size_t b;
+			if constexpr (Monotone) {
+				if (n_ == 0 && (p < cur_ || p - cur_ >= N)) cur_ = p;   // re-anchor an empty queue
+				assert(p >= cur_ && p - cur_ < N && "BucketQueue::push(): priority outside the monotone window");
+				b = static_cast<std::size_t>(p % N);
+			}
+			else {
+				assert(p < N && "BucketQueue::push(): priority out of range");
+				b = p;
+				if (n_ == 0 || p < cur_) cur_ = p;
+			}
+			if (buckets_.empty()) buckets_.resize(N);
+			buckets_[b].emplace_back(std::forward<Args>(args)...);
+			bits_.set(b);
+			++n_;
+		}
+
+		void push(priority_type p, const Value& v) { emplace(p, v); }
+		void push(priority_type p, Value&& v) { emplace(p, std::move(v)); }
+
+		/// @return An element of minimum priority. @pre !empty()
+		[[nodiscard]] const Value& top() const noexcept {
+			assert(n_ > 0 && "BucketQueue::top(): empty queue");
+			return buckets_[min_bucket()].back();
+		}
+
+		/// @return The minimum priority. @pre !empty()
+		[[nodiscard]] priority_type top_priority() const noexcept {
+			assert(n_ > 0 && "BucketQueue::top_priority(): empty queue");
+			min_bucket();
+			return cur_;
+		}
+
+		/// Removes the element returned by @ref top.
+		void pop() noexcept {
+			assert(n_ > 0 && "BucketQueue::pop(): empty queue");
+			const std::size_t b = min_bucket();
+			buckets_[b].pop_back();
+			if (buckets_[b].empty()) bits_.reset(b);
+			--n_;
+		}
+
+		/// Removes all elements (keeps bucket storage); the monotone window restarts at 0 (see @ref emplace).
+		void clear() noexcept {
+			for (std::size_t b = bits_.first(); b != BitTree64<N>::npos; b = bits_.next(b + 1)) buckets_[b].clear();
+			bits_.clear();
+			n_ = 0;
+			cur_ = 0;
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return n_ == 0; }
+		[[nodiscard]] std::size_t size() const noexcept { return n_; }
+		[[nodiscard]] static constexpr std::size_t bucket_count() noexcept { return N; }
+	};
+
+} // namespace kj::detail
@@ -0,0 +1,90 @@
+#pragma once
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <kj/buffer.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Minimal growable array on top of kj::Buffer.
+	 *
+	 * Storage only grows (geometrically); @ref clear destroys the elements but keeps
+	 * the buffer, so containers that repeatedly fill and empty their buckets stop
+	 * allocating after warm-up.
+	 */
+	template <class T>
+	class BufferVector {
+		Buffer<T> buf_{ 0 };
+		std::size_t n_ = 0;
+
+		void grow_(std::size_t min_cap) {
+			const std::size_t cap = std::max<std::size_t>({ min_cap, buf_.size() * 2, 8 });
+			Buffer<T> nb(cap);
+			for (std::size_t i = 0; i < n_; ++i) {
+				::new (static_cast<void*>(nb.data() + i)) T(std::move(buf_[i]));
+				buf_[i].~T();
+			}
+			buf_ = std::move(nb);
+		}
+
+	public:
+		BufferVector() = default;
+		~BufferVector() { clear(); }
+
+		BufferVector(const BufferVector&) = delete;
+		BufferVector& operator=(const BufferVector&) = delete;
+
+		BufferVector(BufferVector&& o) noexcept : buf_(std::move(o.buf_)), n_(o.n_) { o.n_ = 0; }
+		BufferVector& operator=(BufferVector&& o) noexcept {
+			if (this != &o) {
+				clear();
+				buf_ = std::move(o.buf_);
+				n_ = o.n_;
+				o.n_ = 0;
+			}
+			return *this;
+		}
+
+		template <class... Args>
+		T& emplace_back(Args&&... args) {
+			if (n_ == buf_.size()) grow_(n_ + 1);
+			T* p = ::new (static_cast<void*>(buf_.data() + n_)) T(std::forward<Args>(args)...);
+			++n_;
+			return *p;
+		}
+		void push_back(T&& v) { emplace_back(std::move(v)); }
+		void push_back(const T& v) { emplace_back(v); }
+
+		void pop_back() noexcept { buf_[--n_].~T(); }
+
+		/// Destroys all elements; keeps the storage.
+		void clear() noexcept {
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				for (std::size_t i = 0; i < n_; ++i) buf_[i].~T();
+			}
+			n_ = 0;
+		}
+
+		void reserve(std::size_t n) { if (n > buf_.size()) grow_(n); }
+
+		[[nodiscard]] bool empty() const noexcept { return n_ == 0; }
+		[[nodiscard]] std::size_t size() const noexcept { return n_; }
+		[[nodiscard]] std::size_t capacity() const noexcept { return buf_.size(); }
+
+		T* data() noexcept { return buf_.data(); }
+		const T* data() const noexcept { return buf_.data(); }
+		T& operator[](std::size_t i) noexcept { return buf_[i]; }
+		const T& operator[](std::size_t i) const noexcept { return buf_[i]; }
+		T& back() noexcept { return buf_[n_ - 1]; }
+		const T& back() const noexcept { return buf_[n_ - 1]; }
+
+		T* begin() noexcept { return buf_.data(); }
+		T* end() noexcept { return buf_.data() + n_; }
+		const T* begin() const noexcept { return buf_.data(); }
+		const T* end() const noexcept { return buf_.data() + n_; }
+	};
+
+} // namespace kj::detail
@@ -0,0 +1,272 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+#include <bit>
+#include <kj/detail/parallel.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Pixel adjacency used by connected-component labeling.
+	 */
+	enum class Connectivity {
+		four = 4,   ///< Edge neighbours only.
+		eight = 8   ///< Edge and corner neighbours.
+	};
+
+	namespace ccl {
+
+		/// Horizontal run of foreground pixels [x0, x1) in one row.
+		struct Run {
+			int x0;
+			int x1;
+		};
+
+		/**
+		 * @brief Equivalence table over run indices (min-index roots, path halving).
+		 *
+		 * Keeping the smallest index as root means roots are the first run of their
+		 * component in raster order, so final labels come out sequential in one pass.
+		 */
+		struct RunDSU {
+			std::vector<int> p;
+
+			int add() { p.push_back(static_cast<int>(p.size())); return static_cast<int>(p.size()) - 1; }
+
+			int find(int x) {
+				while (p[x] != x) { p[x] = p[p[x]]; x = p[x]; }
+				return x;
+			}
+
+			void unite(int a, int b) {
+				a = find(a); b = find(b);
+				if (a < b) p[b] = a;
+				else if (b < a) p[a] = b;
+			}
+		};
+
+		/// Loads 8 bytes without alignment requirements.
+		inline std::uint64_t load8(const unsigned char* p) noexcept {
+			std::uint64_t v;
+			std::memcpy(&v, p, sizeof v);
+			return v;
+		}
+
+		/// Non-zero iff some byte of @p v is zero (SWAR).
+		inline std::uint64_t has_zero_byte(std::uint64_t v) noexcept {
+			return (v - 0x0101010101010101ull) & ~v & 0x8080808080808080ull;
+		}
+
+		/**
+		 * @brief Appends the foreground runs of one row of @p w pixels to @p out.
+		 *
+		 * Byte-sized pixels are scanned 8 at a time (SWAR) to skip uniform stretches;
+		 * other pixel types use a scalar scan. A pixel is foreground if it is non-zero.
+		 */
+		template <class P>
+		void row_runs(const P* row, int w, std::vector<Run>& out) {
+			int x = 0;
+			if constexpr (sizeof(P) == 1 && std::is_trivially_copyable_v<P>) {
+				const auto* b = reinterpret_cast<const unsigned char*>(row);
+				while (x < w) {
+					while (x + 8 <= w && load8(b + x) == 0) x += 8;            // skip background
+					while (x < w && b[x] == 0) ++x;
+					if (x >= w) break;
+					const int s = x;
+					while (x + 8 <= w && !has_zero_byte(load8(b + x))) x += 8; // skip foreground
+					while (x < w && b[x] != 0) ++x;
+					out.push_back(Run{ s, x });
+				}
+			}
+			else {
+				while (x < w) {
+					while (x < w && row[x] == P{}) ++x;
+					if (x >= w) break;
+					const int s = x;
+					while (x < w && row[x] != P{}) ++x;
+					out.push_back(Run{ s, x });
+				}
+			}
+		}
+
+		/**
+		 * @brief Appends the runs of one packed bit row (LSB-first, @p w bits) to @p out.
+		 *
+		 * Whole 64-pixel words are consumed with count-trailing-zeros/ones.
+		 */
+		inline void bit_row_runs(const std::uint64_t* row, int w, std::vector<Run>& out) {
+			int x = 0;
+			while (x < w) {
+				// skip zeros (bits shifted in from the top read as zeros)
+				for (std::uint64_t v; x < w; x = (x | 63) + 1) {
+					if ((v = row[x >> 6] >> (x & 63)) != 0) { x += std::countr_zero(v); break; }
+				}
+				if (x >= w) break;
+				const int s = x;
+				// skip ones (bits shifted in from the top read as ones)
+				for (std::uint64_t v; x < w; x = (x | 63) + 1) {
+					if ((v = ~row[x >> 6] >> (x & 63)) != 0) { x += std::countr_zero(v); break; }
+				}
+				x = std::min(x, w);
+				out.push_back(Run{ s, x });
+			}
+		}
+
+		/**
+		 * @brief Unites overlapping runs of two consecutive rows.
+		 *
+		 * @param prev  Runs of the upper row, global indices start at @p pi.
+		 * @param cur   Runs of the lower row, global indices start at @p ci.
+		 * @param slack 0 for 4-connectivity, 1 for 8-connectivity (diagonal contact).
+		 */
+		inline void unite_rows(std::span<const Run> prev, int pi, std::span<const Run> cur, int ci,
+			int slack, RunDSU& dsu) {
+			std::size_t i = 0, j = 0;
+			while (i < prev.size() && j < cur.size()) {
+				const Run& a = prev[i];
+				const Run& b = cur[j];
+				if (a.x0 < b.x1 + slack && b.x0 < a.x1 + slack) {
+					dsu.unite(pi + static_cast<int>(i), ci + static_cast<int>(j));
+				}
+				// advance the run that ends first
+				if (a.x1 < b.x1) ++i; else ++j;
+			}
+		}
+
+		/// Runs of a horizontal band of rows [y0, y1).
+		struct Band {
+			int y0 = 0, y1 = 0;
+			std::vector<Run> runs;
+			std::vector<int> row_start;   // size (y1 - y0) + 1, offsets into runs
+			std::vector<int> p;           // local equivalences (indices into runs)
+		};
+
+		/**
+		 * @brief Generic two-pass run-based labeling driver.
+		 *
+		 * @param row_fn Appends the runs of row @c y to a vector: @c row_fn(y, out).
+		 */
+		template <class RowFn>
+		int label(int width, int height, std::span<int> labels, Connectivity conn,
+			unsigned threads, RowFn&& row_fn) {
+			assert(labels.size() >= static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+			if (width <= 0 || height <= 0) return 0;
+			threads = worker_count(threads);
+			const int slack = (conn == Connectivity::eight) ? 1 : 0;
+
+			// Pass 1 (per band): extract runs and unite them within the band.
+			const int nb = static_cast<int>(std::min<unsigned>(threads, static_cast<unsigned>(height)));
+			std::vector<Band> bands(nb);
+			parallel_for(nb, threads, [&](int b) {
+				Band& band = bands[b];
+				band.y0 = static_cast<int>(static_cast<long long>(height) * b / nb);
+				band.y1 = static_cast<int>(static_cast<long long>(height) * (b + 1) / nb);
+				band.row_start.reserve(static_cast<std::size_t>(band.y1 - band.y0) + 1);
+				RunDSU dsu;
+				for (int y = band.y0; y < band.y1; ++y) {
+					const int s = static_cast<int>(band.runs.size());
+					band.row_start.push_back(s);
+					row_fn(y, band.runs);
+					const int e = static_cast<int>(band.runs.size());
+					for (int i = s; i < e; ++i) dsu.add();
+					if (y > band.y0) {
+						const int ps = band.row_start[band.row_start.size() - 2];
+						std::span<const Run> all(band.runs);
+						unite_rows(all.subspan(ps, s - ps), ps, all.subspan(s, e - s), s, slack, dsu);
+					}
+				}
+				band.row_start.push_back(static_cast<int>(band.runs.size()));
+				band.p = std::move(dsu.p);
+			});
+
+			// Join bands into one equivalence table and merge band borders.
+			std::vector<int> offset(nb + 1, 0);
+			for (int b = 0; b < nb; ++b) offset[b + 1] = offset[b] + static_cast<int>(bands[b].runs.size());
+			RunDSU dsu;
+			dsu.p.resize(static_cast<std::size_t>(offset[nb]));
+			parallel_for(nb, threads, [&](int b) {
+				for (std::size_t i = 0; i < bands[b].p.size(); ++i) dsu.p[offset[b] + i] = bands[b].p[i] + offset[b];
+			});
+			for (int b = 1; b < nb; ++b) {
+				const Band& up = bands[b - 1];
+				const Band& lo = bands[b];
+				const int urows = up.y1 - up.y0;
+				const int us = up.row_start[urows - 1], ue = up.row_start[urows];
+				const int ls = lo.row_start[0], le = lo.row_start[1];
+				unite_rows(std::span<const Run>(up.runs).subspan(us, ue - us), offset[b - 1] + us,
+					std::span<const Run>(lo.runs).subspan(ls, le - ls), offset[b] + ls, slack, dsu);
+			}
+
+			// Resolve roots to sequential labels (roots precede members in raster order).
+			std::vector<int> lab(dsu.p.size());
+			int count = 0;
+			for (std::size_t i = 0; i < dsu.p.size(); ++i) {
+				const int r = dsu.find(static_cast<int>(i));
+				lab[i] = (r == static_cast<int>(i)) ? ++count : lab[r];
+			}
+
+			// Pass 2 (per band): write labels.
+			parallel_for(nb, threads, [&](int b) {
+				const Band& band = bands[b];
+				for (int y = band.y0; y < band.y1; ++y) {
+					int* out = labels.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(width);
+					std::fill(out, out + width, 0);
+					const int r = y - band.y0;
+					for (int i = band.row_start[r]; i < band.row_start[r + 1]; ++i) {
+						const Run& run = band.runs[i];
+						std::fill(out + run.x0, out + run.x1, lab[offset[b] + i]);
+					}
+				}
+			});
+			return count;
+		}
+
+	} // namespace ccl
+
+	/**
+	 * @brief Labels connected components of non-zero pixels in a row-major grid.
+	 *
+	 * Two-pass run-based algorithm: pass 1 extracts horizontal runs (8 bytes at a time
+	 * for byte pixels) and unites overlapping runs of consecutive rows in a run-level
+	 * DSU; pass 2 writes the resolved label of each run. With @p threads > 1 the rows are
+	 * split into bands processed in parallel, and the band borders are merged in between.
+	 *
+	 * @param pixels  Grid of @p width x @p height pixels, row-major.
+	 * @param width   Grid width.
+	 * @param height  Grid height.
+	 * @param labels  Output, same layout: 0 for background, 1..k for components in raster order.
+	 * @param conn    Pixel adjacency.
+	 * @param threads Number of bands/workers (1 = sequential, 0 = hardware concurrency).
+	 * @return Number of components k.
+	 */
+	template <class P>
+	int label_components(std::span<const P> pixels, int width, int height, std::span<int> labels,
+		Connectivity conn = Connectivity::four, unsigned threads = 1) {
+		assert(pixels.size() >= static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+		return ccl::label(width, height, labels, conn, threads, [&](int y, std::vector<ccl::Run>& out) {
+			ccl::row_runs(pixels.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(width), width, out);
+		});
+	}
+
+	/**
+	 * @brief Labels connected components of set bits in a packed bit grid.
+	 *
+	 * Each row holds @p width pixels in @c (width + 63) / 64 words, pixel @c x at bit
+	 * @c x % 64 of word @c x / 64 (LSB first). Otherwise identical to @ref label_components.
+	 */
+	inline int label_components_bits(std::span<const std::uint64_t> bits, int width, int height,
+		std::span<int> labels, Connectivity conn = Connectivity::four, unsigned threads = 1) {
+		const std::size_t stride = (static_cast<std::size_t>(width) + 63) / 64;
+		assert(bits.size() >= stride * static_cast<std::size_t>(height));
+		return ccl::label(width, height, labels, conn, threads, [&](int y, std::vector<ccl::Run>& out) {
+			ccl::bit_row_runs(bits.data() + static_cast<std::size_t>(y) * stride, width, out);
+		});
+	}
+
+} // namespace kj::detail
@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @file config.hpp
+ * @brief Compiler portability macros shared by the kj headers.
+ */
+
+/**
+ * @brief Portable spelling of [[no_unique_address]].
+ *
+ * MSVC accepts the standard attribute but ignores it for ABI reasons; its own
+ * [[msvc::no_unique_address]] has the intended effect (VS 2019 16.9+).
+ */
+#if defined(_MSC_VER) && _MSC_VER >= 1929
+#define KJ_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#elif defined(__has_cpp_attribute)
+#if __has_cpp_attribute(no_unique_address)
+#define KJ_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#else
+#define KJ_NO_UNIQUE_ADDRESS
+#endif
+#else
+#define KJ_NO_UNIQUE_ADDRESS
+#endif
@@ -0,0 +1,347 @@
+#pragma once
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <kj/buffer.hpp>
+#include <kj/scope_guard.hpp>
+
+namespace kj::detail {
+
+	/// True if @p Comp is a plain less/greater on arithmetic @p T (enables the vectorizable scan).
+	template <class T, class Comp>
+	inline constexpr bool dary_simd_compare_v = std::is_arithmetic_v<T> &&
+		(std::is_same_v<Comp, std::less<T>> || std::is_same_v<Comp, std::less<>> ||
+			std::is_same_v<Comp, std::greater<T>> || std::is_same_v<Comp, std::greater<>>);
+
+	/**
+	 * @brief Implicit D-ary array heap stored in a growable, cache-line aligned kj::Buffer.
+	 *
+	 * By default this is a min-heap via @p std::less<T>. Elements live in one contiguous
+	 * buffer aligned to 64 bytes and shifted by D-1 slots, so the D children of every node
+	 * start on a multiple of D; with @c D * sizeof(T) == 64 each child group is exactly one
+	 * cache line. For arithmetic keys with std::less/std::greater, a full child group is
+	 * scanned with a branch-free min/max reduction followed by an equality search, which
+	 * compilers turn into SIMD code.
+	 *
+	 * With @p Indexed = true every element carries an integer id in [0, max id] and a
+	 * position map is kept, enabling @ref decrease_key, @ref erase and @ref contains by id.
+	 * Ids are stored in a parallel buffer so keys stay densely packed.
+	 *
+	 * @tparam T       Key type.
+	 * @tparam Comp    Comparator (StrictWeakOrder), defaults to @c std::less<T>.
+	 * @tparam D       Arity (>= 2), e.g. 4, 8 or 16.
+	 * @tparam Indexed If true, maintain an id -> position map (default: false).
+	 */
+	template <class T, class Comp = std::less<T>, std::size_t D = 8, bool Indexed = false>
+	class DaryHeap {
+		static_assert(D >= 2, "DaryHeap: arity must be at least 2");
+
+	public:
+		/// Byte alignment of the key buffer.
+		static constexpr std::size_t alignment = std::max<std::size_t>(64, alignof(T));
+
+	private:
+		static constexpr std::size_t offset_ = D - 1;   // shift so child groups are aligned
+
+		Buffer<T> keys_{ 0 };
+		// Ids and position map present only if Indexed (otherwise no storage cost)
+		[[no_unique_address]] std::conditional_t<Indexed, Buffer<int>, char> ids_{ 0 };
+		[[no_unique_address]] std::conditional_t<Indexed, std::vector<int>, char> pos_{};
+		std::size_t n_ = 0;
+		std::size_t cap_ = 0;
+		[[no_unique_address]] Comp cmp_{};
+
+		T* a() noexcept { return keys_.data() + offset_; }
+		const T* a() const noexcept { return keys_.data() + offset_; }
+
+		// ---- storage -------------------------------------------------------------
+		void grow_(std::size_t min_cap) {
+			std::size_t cap = std::max<std::size_t>({ min_cap, cap_ * 2, 16 });
+			Buffer<T> nk(cap + offset_, alignment);
+			T* dst = nk.data() + offset_;
+			for (std::size_t i = 0; i < n_; ++i) {
+				::new (static_cast<void*>(dst + i)) T(std::move(a()[i]));
+				a()[i].~T();
+			}
+			keys_ = std::move(nk);
+			if constexpr (Indexed) {
+				Buffer<int> ni(cap);
+				std::copy(ids_.data(), ids_.data() + n_, ni.data());
+				ids_ = std::move(ni);
+			}
+			cap_ = cap;
+		}
+
+		void destroy_all_() noexcept {
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				for (std::size_t i = 0; i < n_; ++i) a()[i].~T();
+			}
+			n_ = 0;
+		}
+
+		// ---- heap core -----------------------------------------------------------
+		// Index of the best child among the (up to D) children starting at c.
+		std::size_t best_child(std::size_t c) const {
+			const T* k = a() + c;
+			if constexpr (dary_simd_compare_v<T, Comp>) {
+				if (c + D <= n_) {
+					T m = k[0];
+					for (std::size_t i = 1; i < D; ++i) m = cmp_(k[i], m) ? k[i] : m;   // reduction
+					for (std::size_t i = 0; i < D; ++i) if (k[i] == m) return c + i;
+					return c;   // unordered values (NaN): fall back to the first child
+				}
+			}
+			const std::size_t e = std::min(c + D, n_);
+			std::size_t b = c;
+			for (std::size_t i = c + 1; i < e; ++i) if (cmp_(a()[i], a()[b])) b = i;
+			return b;
+		}
+
+		void set_id(std::size_t i, int id) noexcept {
+			if constexpr (Indexed) { ids_[i] = id; pos_[static_cast<std::size_t>(id)] = static_cast<int>(i); }
+		}
+
+		// Moves slot @p from into slot @p to (both constructed), keeping ids in sync.
+		void move_slot(std::size_t to, std::size_t from) {
+			a()[to] = std::move(a()[from]);
+			if constexpr (Indexed) set_id(to, ids_[from]);
+		}
+
+		void sift_up(std::size_t i) {
+			if (i == 0) return;
+			T x = std::move(a()[i]);
+			int id = 0;
+			if constexpr (Indexed) id = ids_[i];
+			while (i > 0) {
+				const std::size_t p = (i - 1) / D;
+				if (!cmp_(x, a()[p])) break;
+				move_slot(i, p);
+				i = p;
+			}
+			a()[i] = std::move(x);
+			set_id(i, id);
+		}
+
+		void sift_down(std::size_t i) {
+			T x = std::move(a()[i]);
+			int id = 0;
+			if constexpr (Indexed) id = ids_[i];
+			for (;;) {
+				const std::size_t c = D * i + 1;
+				if (c >= n_) break;
+				const std::size_t b = best_child(c);
+				if (!cmp_(a()[b], x)) break;
+				move_slot(i, b);
+				i = b;
+			}
+			a()[i] = std::move(x);
+			set_id(i, id);
+		}
+
+		void heapify_() {
+			if (n_ < 2) return;
+			for (std::size_t i = (n_ - 2) / D + 1; i-- > 0; ) sift_down(i);
+		}
+
+		// Removes slot i (constructed) by moving the last element into it.
+		void remove_at(std::size_t i) {
+			if constexpr (Indexed) pos_[static_cast<std::size_t>(ids_[i])] = -1;
+			const std::size_t last = --n_;
+			if (i != last) {
+				a()[i] = std::move(a()[last]);
+				if constexpr (Indexed) set_id(i, ids_[last]);
+			}
+			a()[last].~T();
+			if (i != last) {
+				if (i > 0 && cmp_(a()[i], a()[(i - 1) / D])) sift_up(i);
+				else sift_down(i);
+			}
+		}
+
+	public:
+		//-------------------------------------------------------------------------
+		// Construction / destruction
+		//-------------------------------------------------------------------------
+
+		/// Constructs an empty heap.
+		DaryHeap() = default;
+
+		/// Constructs an empty heap with a custom comparator.
+		explicit DaryHeap(const Comp& c) : cmp_(c) {}
+
+		/**
+		 * @brief Builds a heap from [@p first, @p last) with Floyd's O(n) heapify (non-indexed only).
+		 */
+		template <class It, bool I = Indexed, std::enable_if_t<!I && std::is_base_of_v<std::forward_iterator_tag,
+			typename std::iterator_traits<It>::iterator_category>, int> = 0>
+		DaryHeap(It first, It last, const Comp& c = Comp{}) : cmp_(c) {
+			push_range(first, last);
+		}
+
+		~DaryHeap() { destroy_all_(); }
+
+		DaryHeap(const DaryHeap&) = delete;
+		DaryHeap& operator=(const DaryHeap&) = delete;
+
+		DaryHeap(DaryHeap&& other) noexcept
+			: keys_(std::move(other.keys_)), ids_(std::move(other.ids_)), pos_(std::move(other.pos_)),
+			n_(other.n_), cap_(other.cap_), cmp_(std::move(other.cmp_)) {
+			other.n_ = 0; other.cap_ = 0;
+		}
+		DaryHeap& operator=(DaryHeap&& other) noexcept {
+			if (this != &other) {
+				destroy_all_();
+				keys_ = std::move(other.keys_);
+				ids_ = std::move(other.ids_);
+				pos_ = std::move(other.pos_);
+				n_ = other.n_; cap_ = other.cap_;
+				cmp_ = std::move(other.cmp_);
+				other.n_ = 0; other.cap_ = 0;
+			}
+			return *this;
+		}
+
+		//-------------------------------------------------------------------------
+		// Capacity
+		//-------------------------------------------------------------------------
+
+		/// Ensures room for @p n elements without reallocation.
+		void reserve(std::size_t n) { if (n > cap_) grow_(n); }
+
+		/// @return Number of elements that fit without reallocation.
+		[[nodiscard]] std::size_t capacity() const noexcept { return cap_; }
+
+		//-------------------------------------------------------------------------
+		// Observers
+		//-------------------------------------------------------------------------
+
+		/// Removes all elements (keeps the buffer).
+		void clear() noexcept {
+			if constexpr (Indexed) {
+				for (std::size_t i = 0; i < n_; ++i) pos_[static_cast<std::size_t>(ids_[i])] = -1;
+			}
+			destroy_all_();
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return n_ == 0; }
+		[[nodiscard]] std::size_t size() const noexcept { return n_; }
+		[[nodiscard]] const T& top() const noexcept { return a()[0]; }
+		[[nodiscard]] const Comp& comparator() const noexcept { return cmp_; }
+
+		//-------------------------------------------------------------------------
+		// Modifiers (non-indexed)
+		//-------------------------------------------------------------------------
+
+		template <bool I = Indexed, std::enable_if_t<!I, int> = 0>
+		void push(const T& v) { emplace(v); }
+
+		template <bool I = Indexed, std::enable_if_t<!I, int> = 0>
+		void push(T&& v) { emplace(std::move(v)); }
+
+		template <class... Args, bool I = Indexed, std::enable_if_t<!I, int> = 0>
+		void emplace(Args&&... args) {
+			if (n_ == cap_) grow_(n_ + 1);
+			::new (static_cast<void*>(a() + n_)) T(std::forward<Args>(args)...);
+			sift_up(n_++);
+		}
+
+		/**
+		 * @brief Appends [@p first, @p last) and restores heap order.
+		 *
+		 * Uses Floyd's bottom-up heapify (O(n + k)) when the batch is large compared to the
+		 * heap, and individual sift-ups (O(k log n)) otherwise. If copying an element throws,
+		 * the heap keeps its previous contents (bulk path) or the elements pushed so far.
+		 */
+		template <class It, bool I = Indexed, std::enable_if_t<!I, int> = 0>
+		void push_range(It first, It last) {
+			const auto k = static_cast<std::size_t>(std::distance(first, last));
+			reserve(n_ + k);
+			if (k <= n_ / 4) {
+				for (; first != last; ++first) emplace(*first);
+				return;
+			}
+			// The appended tail is unordered until heapify_, so a failed copy drops it.
+			const std::size_t n0 = n_;
+			auto unwind = scope_exit([&]() noexcept {
+				if constexpr (!std::is_trivially_destructible_v<T>) {
+					for (std::size_t i = n0; i < n_; ++i) a()[i].~T();
+				}
+				n_ = n0;
+			});
+			for (; first != last; ++first) {
+				::new (static_cast<void*>(a() + n_)) T(*first);
+				++n_;
+			}
+			unwind.dismiss();
+			heapify_();
+		}
+
+		/// Removes the top element.
+		void pop() { remove_at(0); }
+
+		/**
+		 * @brief Replaces the top element by @p v with a single sift-down (pop + push in one pass).
+		 */
+		template <bool I = Indexed, std::enable_if_t<!I, int> = 0>
+		void replace_top(T v) {
+			a()[0] = std::move(v);
+			sift_down(0);
+		}
+
+		//-------------------------------------------------------------------------
+		// Modifiers and observers (indexed)
+		//-------------------------------------------------------------------------
+
+		/**
+		 * @brief Inserts key @p v under @p id (which must not be in the heap).
+		 */
+		template <bool I = Indexed, std::enable_if_t<I, int> = 0>
+		void push(int id, T v) {
+			assert(id >= 0 && !contains(id) && "DaryHeap::push(): id already present");
+			if (static_cast<std::size_t>(id) >= pos_.size()) pos_.resize(static_cast<std::size_t>(id) + 1, -1);
+			if (n_ == cap_) grow_(n_ + 1);
+			::new (static_cast<void*>(a() + n_)) T(std::move(v));
+			set_id(n_, id);
+			sift_up(n_++);
+		}
+
+		/// @return Id of the top element.
+		template <bool I = Indexed, std::enable_if_t<I, int> = 0>
+		[[nodiscard]] int top_id() const noexcept { return ids_[0]; }
+
+		/// @return Whether @p id is currently in the heap.
+		template <bool I = Indexed, std::enable_if_t<I, int> = 0>
+		[[nodiscard]] bool contains(int id) const noexcept {
+			return static_cast<std::size_t>(id) < pos_.size() && pos_[static_cast<std::size_t>(id)] >= 0;
+		}
+
+		/// @return Key stored under @p id (which must be in the heap).
+		template <bool I = Indexed, std::enable_if_t<I, int> = 0>
+		[[nodiscard]] const T& key(int id) const noexcept { return a()[static_cast<std::size_t>(pos_[static_cast<std::size_t>(id)])]; }
+
+		/**
+		 * @brief Replaces the key of @p id by @p v, which must not compare worse (O(log_D n)).
+		 */
+		template <bool I = Indexed, std::enable_if_t<I, int> = 0>
+		void decrease_key(int id, T v) {
+			const auto i = static_cast<std::size_t>(pos_[static_cast<std::size_t>(id)]);
+			assert(!cmp_(a()[i], v) && "decrease_key(): new key is worse than the old one");
+			a()[i] = std::move(v);
+			sift_up(i);
+		}
+
+		/**
+		 * @brief Removes the element stored under @p id (which must be in the heap).
+		 */
+		template <bool I = Indexed, std::enable_if_t<I, int> = 0>
+		void erase(int id) { remove_at(static_cast<std::size_t>(pos_[static_cast<std::size_t>(id)])); }
+	};
+
+} // namespace kj::detail
@@ -2,9 +2,73 @@
 #include <vector>
 #include <utility>
 #include <cstddef>
+#include <span>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <bit>
+#include <kj/scope_guard.hpp>
+#include <kj/detail/config.hpp>
+#include <kj/detail/parallel.hpp>
 
 namespace kj::detail {
 
+	/**
+	 * @brief Default @ref BasicDSU instrumentation policy: records nothing.
+	 *
+	 * All hooks are empty and the policy is stored with KJ_NO_UNIQUE_ADDRESS (the
+	 * MSVC-aware spelling of [[no_unique_address]]), so a non-instrumented DSU has the
+	 * same size and code as before on every supported compiler.
+	 */
+	struct NullDSUStats {
+		static constexpr void on_find(int /*visited*/, int /*writes*/) noexcept {}
+		static constexpr void on_unite(bool /*merged*/) noexcept {}
+	};
+
+	/**
+	 * @brief Counters collected by @ref DSUStats.
+	 *
+	 * @c path_hist[k] counts finds that visited a number of nodes @c v with
+	 * @c std::bit_width(v) == k, i.e. bucket 0 is v == 0 (x was a root), bucket 1 is v == 1,
+	 * bucket 2 is v in [2, 3], bucket 3 is v in [4, 7], and so on.
+	 */
+	struct DSUStatsSnapshot {
+		std::uint64_t finds = 0;             ///< Calls to find (including those made by unite/same/size).
+		std::uint64_t unites = 0;            ///< Calls to unite.
+		std::uint64_t merges = 0;            ///< Unites that actually merged two sets.
+		std::uint64_t visited = 0;           ///< Total parent links followed by all finds.
+		std::uint64_t compress_writes = 0;   ///< Parent entries rewritten by path compression.
+		std::array<std::uint64_t, 33> path_hist{};  ///< Log2 histogram of links followed per find.
+	};
+
+	/**
+	 * @brief Opt-in @ref BasicDSU instrumentation policy (operation and path-length counters).
+	 */
+	struct DSUStats {
+		/// Raw counters.
+		DSUStatsSnapshot data;
+
+		void on_find(int visited, int writes) noexcept {
+			++data.finds;
+			data.visited += static_cast<std::uint64_t>(visited);
+			data.compress_writes += static_cast<std::uint64_t>(writes);
+			++data.path_hist[std::bit_width(static_cast<unsigned>(visited))];
+		}
+		void on_unite(bool merged) noexcept {
+			++data.unites;
+			data.merges += merged ? 1u : 0u;
+		}
+
+		/// @return Copy of the current counters.
+		DSUStatsSnapshot snapshot() const noexcept { return data; }
+
+		/// Zeroes all counters.
+		void clear() noexcept { data = DSUStatsSnapshot{}; }
+	};
+
 	/**
 	 * @brief Disjoint Set Union (Union-Find) with union-by-size and path compression.
 	 *
@@ -17,16 +81,21 @@ namespace kj::detail {
 	 * Implementation uses a single vector<int> `p`, where:
 	 * - `p[x] < 0` encodes that x is a root and `-p[x]` is the size of the set,
 	 * - `p[x] >= 0` encodes that `p[x]` is the parent of x.
+	 *
+	 * @tparam Stats Instrumentation policy (@ref NullDSUStats or @ref DSUStats).
 	 */
-	struct DSU {
+	template <class Stats = NullDSUStats>
+	struct BasicDSU {
 		/// Parent/size array (see class description).
 		std::vector<int> p;
+		/// Instrumentation policy instance (empty for @ref NullDSUStats).
+		KJ_NO_UNIQUE_ADDRESS Stats stats{};
 
 		/**
 		 * @brief Constructs a DSU of @p n singleton sets (0..n-1).
 		 * @param n Number of elements (defaults to 0).
 		 */
-		explicit DSU(int n = 0) : p(n, -1) {}
+		explicit BasicDSU(int n = 0) : p(n, -1) {}
 
 		/**
 		 * @brief Resets the structure to @p n singleton sets.
@@ -43,13 +112,15 @@ namespace kj::detail {
 		 * @return The index of the root representative of @p x.
 		 */
 		int find(int x) {
-			int r = x;
-			while (p[r] >= 0) r = p[r];        // climb to root
+			int r = x, visited = 0, writes = 0;
+			while (p[r] >= 0) { r = p[r]; ++visited; }  // climb to root
 			while (x != r) {                   // path compression
 				int up = p[x];
+				writes += (up != r);
 				p[x] = r;
 				x = up;
 			}
+			stats.on_find(visited, writes);
 			return r;
 		}
 
@@ -64,6 +135,7 @@ namespace kj::detail {
 		 */
 		bool unite(int a, int b) {
 			a = find(a); b = find(b);
+			stats.on_unite(a != b);
 			if (a == b) return false;
 			// p[root] is negative size: "greater" means smaller absolute size.
 			if (p[a] > p[b]) std::swap(a, b);
@@ -86,6 +158,363 @@ namespace kj::detail {
 		 * @brief Returns the current universe size (number of elements).
 		 */
 		std::size_t universe() const { return p.size(); }
+
+		/**
+		 * @brief Merges the partition of @p other (same universe) into this structure.
+		 *
+		 * Every non-root element of @p other is united with its parent there; since
+		 * parent links span each of its sets, the result is the join of both partitions.
+		 * Only the parent array of @p other is read, so it stays untouched.
+		 *
+		 * @param other DSU over the same universe (e.g., built by another shard of edges).
+		 * @return Number of merges that actually happened in this structure.
+		 */
+		int absorb(const BasicDSU& other) {
+			assert(other.p.size() == p.size() && "DSU::absorb(): universe mismatch");
+			int merged = 0;
+			const int n = static_cast<int>(other.p.size());
+			for (int i = 0; i < n; ++i) {
+				if (other.p[i] >= 0 && unite(i, other.p[i])) ++merged;
+			}
+			return merged;
+		}
+	};
+
+	/**
+	 * @brief Classic DSU without instrumentation.
+	 */
+	using DSU = BasicDSU<>;
+
+	/**
+	 * @brief DSU that counts operations and records find path lengths.
+	 *
+	 * @see DSUStats
+	 */
+	using InstrumentedDSU = BasicDSU<DSUStats>;
+
+	/**
+	 * @brief Merges many shard DSUs (same universe) into @c shards[0] by a parallel tree reduction.
+	 *
+	 * Level @c s absorbs @c shards[i+s] into @c shards[i] for every @c i that is a multiple
+	 * of @c 2s; pairs within a level are independent and are spread over @p threads workers.
+	 * After the call @c shards[0] holds the union of all partitions, the other shards are
+	 * left in an unspecified (but valid) state.
+	 *
+	 * @param shards  Shard states to merge; may be empty.
+	 * @param threads Worker count (0 = @c std::thread::hardware_concurrency()).
+	 */
+	inline void merge_shards(std::span<DSU> shards, unsigned threads = 0) {
+		pairwise_reduce(shards.size(), worker_count(threads), [&](std::size_t i, std::size_t j) {
+			shards[i].absorb(shards[j]);
+		});
+	}
+
+
+	/**
+	 * @brief Smallest signed integer type able to hold -N .. N-1 (used by @ref FixedDSU).
+	 */
+	template <std::size_t N>
+	using fixed_dsu_index_t =
+		std::conditional_t<(N <= 0x7F), std::int8_t,
+		std::conditional_t<(N <= 0x7FFF), std::int16_t, std::int32_t>>;
+
+	/**
+	 * @brief Fixed-capacity DSU over {0..N-1} with no heap allocation.
+	 *
+	 * Same encoding and algorithms as @ref DSU (union-by-size + path compression), stored in
+	 * a @c std::array of the narrowest signed index type for @p N. All operations are
+	 * @c constexpr, and @ref reset is a single memset (every entry is -1, i.e. all bits set).
+	 *
+	 * @tparam N Universe size.
+	 */
+	template <std::size_t N>
+	struct FixedDSU {
+		static_assert(N <= 0x7FFFFFFF, "FixedDSU: universe too large");
+
+		/// Index/size type chosen from @p N.
+		using index_type = fixed_dsu_index_t<N>;
+
+		/// Parent/size array (see @ref DSU).
+		std::array<index_type, N> p;
+
+		/**
+		 * @brief Constructs @p N singleton sets.
+		 */
+		constexpr FixedDSU() noexcept { reset(); }
+
+		/**
+		 * @brief Resets to @p N singleton sets.
+		 */
+		constexpr void reset() noexcept {
+			if (std::is_constant_evaluated()) {
+				for (auto& v : p) v = -1;
+			}
+			else {
+				std::memset(p.data(), 0xFF, sizeof(p));
+			}
+		}
+
+		/**
+		 * @brief Finds the representative of @p x with path compression.
+		 */
+		constexpr int find(int x) noexcept {
+			int r = x;
+			while (p[r] >= 0) r = p[r];
+			while (x != r) {
+				const int up = p[x];
+				p[x] = static_cast<index_type>(r);
+				x = up;
+			}
+			return r;
+		}
+
+		/**
+		 * @brief Merges the sets containing @p a and @p b (union-by-size).
+		 * @return @c true if a merge actually happened.
+		 */
+		constexpr bool unite(int a, int b) noexcept {
+			a = find(a); b = find(b);
+			if (a == b) return false;
+			if (p[a] > p[b]) std::swap(a, b);
+			p[a] = static_cast<index_type>(p[a] + p[b]);
+			p[b] = static_cast<index_type>(a);
+			return true;
+		}
+
+		/**
+		 * @brief Checks if @p a and @p b belong to the same set.
+		 */
+		constexpr bool same(int a, int b) noexcept { return find(a) == find(b); }
+
+		/**
+		 * @brief Returns the size of the set containing @p x.
+		 */
+		constexpr int size(int x) noexcept { return -p[find(x)]; }
+
+		/**
+		 * @brief Returns the universe size @p N.
+		 */
+		static constexpr std::size_t universe() noexcept { return N; }
+	};
+
+
+	/**
+	 * @brief DSU with a parity bit per element (bipartiteness / 2-coloring).
+	 *
+	 * Maintains, for every element, the xor-parity of its path to the root, so that
+	 * constraints of the form "a and b have equal/different colors" can be merged and
+	 * checked in near-O(1) amortized time (union-by-size + path compression).
+	 *
+	 * The parity bit is packed into the parent word, so memory is the same as @ref DSU:
+	 * - `p[x] < 0`  : x is a root and `-p[x]` is the size of the set,
+	 * - `p[x] >= 0` : `p[x] >> 1` is the parent of x and `p[x] & 1` the parity of that edge.
+	 *
+	 * The universe is therefore limited to 2^30 elements.
+	 */
+	struct ParityDSU {
+		/// Packed parent/parity or negative size (see class description).
+		std::vector<int> p;
+		/// First edge rejected by @ref unite, or (-1, -1) if the constraints are consistent.
+		std::pair<int, int> conflict{ -1, -1 };
+
+		/**
+		 * @brief Constructs a parity DSU of @p n singleton sets (0..n-1).
+		 * @param n Number of elements (defaults to 0).
+		 */
+		explicit ParityDSU(int n = 0) : p(n, -1) {}
+
+		/**
+		 * @brief Resets to @p n singleton sets and forgets any recorded conflict.
+		 */
+		void reset(int n) { p.assign(n, -1); conflict = { -1, -1 }; }
+
+		/**
+		 * @brief Finds the root of @p x together with the parity of @p x relative to it.
+		 *
+		 * Uses path compression; compressed links keep the accumulated parity.
+		 *
+		 * @param x Element id in [0, size()).
+		 * @return Pair (root, parity).
+		 */
+		std::pair<int, int> find_parity(int x) {
+			int r = x, par = 0;
+			while (p[r] >= 0) { par ^= p[r] & 1; r = p[r] >> 1; }   // climb to root
+			const int total = par;
+			while (x != r) {                                          // path compression
+				const int up = p[x];
+				p[x] = (r << 1) | par;
+				par ^= up & 1;
+				x = up >> 1;
+			}
+			return { r, total };
+		}
+
+		/**
+		 * @brief Finds the representative (root) of the set containing @p x.
+		 */
+		int find(int x) { return find_parity(x).first; }
+
+		/**
+		 * @brief Returns the color (0/1) of @p x relative to its set representative.
+		 *
+		 * While no conflict has been recorded, colors form a proper 2-coloring of every set.
+		 */
+		int color(int x) { return find_parity(x).second; }
+
+		/**
+		 * @brief Adds the constraint color(a) xor color(b) == @p odd.
+		 *
+		 * With the default @p odd = true this is a graph edge that must join different colors.
+		 * A constraint that contradicts the existing ones (an odd cycle for edges) is rejected,
+		 * and the first such pair is stored in @ref conflict.
+		 *
+		 * @return @c false if the constraint is contradictory, @c true otherwise.
+		 */
+		bool unite(int a, int b, bool odd = true) {
+			auto [ra, pa] = find_parity(a);
+			auto [rb, pb] = find_parity(b);
+			const int d = pa ^ pb ^ static_cast<int>(odd);
+			if (ra == rb) {
+				if (d == 0) return true;
+				if (conflict.first < 0) conflict = { a, b };
+				return false;
+			}
+			if (p[ra] > p[rb]) std::swap(ra, rb);
+			p[ra] += p[rb];
+			p[rb] = (ra << 1) | d;
+			return true;
+		}
+
+		/**
+		 * @brief Checks if @p a and @p b belong to the same set.
+		 */
+		bool same(int a, int b) { return find(a) == find(b); }
+
+		/**
+		 * @brief Returns the size of the set containing @p x.
+		 */
+		int size(int x) { return -p[find(x)]; }
+
+		/**
+		 * @brief Returns @c true while no contradictory constraint has been added.
+		 */
+		bool bipartite() const { return conflict.first < 0; }
+
+		/**
+		 * @brief Returns the current universe size (number of elements).
+		 */
+		std::size_t universe() const { return p.size(); }
+	};
+
+
+	/**
+	 * @brief Union-Find that remembers when every pair of elements became connected.
+	 *
+	 * Each call to @ref unite is one time step (the edge index, starting at 0). Links are
+	 * created by union-by-size without path compression and stamped with their time step,
+	 * so stamps strictly increase towards the root and the tree height stays O(log n).
+	 * @ref connected_time walks both paths upward, always advancing the endpoint with the
+	 * older link, and returns the stamp of the last link crossed.
+	 *
+	 * Parent and stamp are stored side by side in one 8-byte record so every step of a
+	 * query touches a single cache line:
+	 * - `n[x].p < 0`  : x is a root, `-n[x].p` is the set size and `n[x].t == never`,
+	 * - `n[x].p >= 0` : `n[x].p` is the parent of x and `n[x].t` the time of that link.
+	 */
+	struct TimedDSU {
+		/// Stamp of root records; also returned by queries for never-connected pairs.
+		static constexpr std::uint32_t never = 0xFFFFFFFFu;
+
+		/// Packed per-element record (see class description).
+		struct Link {
+			int           p;
+			std::uint32_t t;
+		};
+
+		/// Per-element parent/size and link stamp.
+		std::vector<Link> n;
+		/// Time step assigned to the next @ref unite call.
+		std::uint32_t now = 0;
+
+		/**
+		 * @brief Constructs a timed DSU of @p sz singleton sets at time 0.
+		 * @param sz Number of elements (defaults to 0).
+		 */
+		explicit TimedDSU(int sz = 0) : n(sz, Link{ -1, never }) {}
+
+		/**
+		 * @brief Resets to @p sz singleton sets and rewinds the clock to 0.
+		 */
+		void reset(int sz) { n.assign(sz, Link{ -1, never }); now = 0; }
+
+		/**
+		 * @brief Finds the root representative of @p x (no path compression).
+		 */
+		int find(int x) const {
+			while (n[x].p >= 0) x = n[x].p;
+			return x;
+		}
+
+		/**
+		 * @brief Processes edge number @ref now between @p a and @p b and advances the clock.
+		 * @return @c true if a merge happened, @c false if already connected.
+		 */
+		bool unite(int a, int b) {
+			const std::uint32_t t = now++;
+			a = find(a); b = find(b);
+			if (a == b) return false;
+			if (n[a].p > n[b].p) std::swap(a, b);   // attach smaller (by size) under larger
+			n[a].p += n[b].p;
+			n[b] = Link{ a, t };
+			return true;
+		}
+
+		/**
+		 * @brief Returns the time step at which @p a and @p b first became connected.
+		 *
+		 * Runs in O(log n). A pair with @p a == @p b is connected from the start (time 0).
+		 *
+		 * @return Edge index in [0, now), 0 for @p a == @p b, or @ref never if not connected.
+		 */
+		std::uint32_t connected_time(int a, int b) const {
+			std::uint32_t t = 0;
+			while (a != b) {
+				if (n[a].t > n[b].t) std::swap(a, b);  // advance the older link
+				if (n[a].t == never) return never;     // both are roots
+				t = n[a].t;
+				a = n[a].p;
+			}
+			return t;
+		}
+
+		/**
+		 * @brief Answers many @ref connected_time queries at once.
+		 *
+		 * @param queries Pairs (a, b).
+		 * @param out     Destination, must have at least @c queries.size() elements.
+		 */
+		void connected_time(std::span<const std::pair<int, int>> queries,
+			std::span<std::uint32_t> out) const {
+			assert(out.size() >= queries.size());
+			for (std::size_t i = 0; i < queries.size(); ++i) {
+				out[i] = connected_time(queries[i].first, queries[i].second);
+			}
+		}
+
+		/**
+		 * @brief Checks if @p a and @p b are connected at the current time.
+		 */
+		bool same(int a, int b) const { return find(a) == find(b); }
+
+		/**
+		 * @brief Returns the size of the set containing @p x.
+		 */
+		int size(int x) const { return -n[find(x)].p; }
+
+		/**
+		 * @brief Returns the current universe size (number of elements).
+		 */
+		std::size_t universe() const { return n.size(); }
 	};
 
 
@@ -178,4 +607,55 @@ namespace kj::detail {
 		std::size_t universe() const { return p.size(); }
 	};
 
+
+	/**
+	 * @brief RAII transaction over a @ref RollbackDSU, built on kj::ScopeGuard.
+	 *
+	 * Takes a snapshot on construction and rolls back to it on scope exit unless
+	 * @ref commit was called. Transactions nest: committing an inner one keeps its unions
+	 * as part of the enclosing transaction, which may still roll them back.
+	 *
+	 * The guard stores a plain (pointer, token) functor, so an exit with no changes costs a
+	 * single stack-size compare.
+	 *
+	 * Example:
+	 * @code
+	 * kj::RollbackTransaction tx(dsu);
+	 * if (!dsu.unite(a, b)) return false;   // rolled back automatically
+	 * tx.commit();
+	 * @endcode
+	 */
+	class RollbackTransaction {
+	public:
+		/// Rollback action executed by the guard.
+		struct Undo {
+			RollbackDSU* dsu;
+			int          token;
+			void operator()() const noexcept { dsu->rollback(token); }
+		};
+
+		/**
+		 * @brief Opens a transaction on @p dsu (takes a snapshot).
+		 */
+		explicit RollbackTransaction(RollbackDSU& dsu) noexcept
+			: guard_(Undo{ &dsu, dsu.snapshot() }) {
+		}
+
+		RollbackTransaction(const RollbackTransaction&) = delete;
+		RollbackTransaction& operator=(const RollbackTransaction&) = delete;
+
+		/**
+		 * @brief Keeps all changes made since the transaction was opened.
+		 */
+		void commit() noexcept { guard_.dismiss(); }
+
+		/**
+		 * @brief Returns the snapshot token taken on entry.
+		 */
+		int token() const noexcept { return guard_.callable().token; }
+
+	private:
+		ScopeGuard<Undo> guard_;
+	};
+
 } // namespace kj::detail
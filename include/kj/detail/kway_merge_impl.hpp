@@ -0,0 +1,156 @@
+#pragma once
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <kj/view.hpp>
+#include <kj/detail/parallel.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Melds all heaps into @c heaps[0] along a balanced tournament tree.
+	 *
+	 * Round @c s melds @c heaps[i+s] into @c heaps[i] for every @c i that is a multiple of
+	 * @c 2s, so every heap takes part in O(log k) melds of similar-sized inputs instead of
+	 * one long chain. Pairs within a round are independent and are spread over @p threads
+	 * workers; that is only safe if no two heaps share a node pool (unpooled heaps, or
+	 * pooled heaps with their own pools). The other heaps are left empty.
+	 *
+	 * @tparam Heap Any kj heap with @c merge(Heap&) (SkewHeap, PairingHeap, ...).
+	 * @param threads Worker count (0 = @c std::thread::hardware_concurrency()).
+	 */
+	template <class Heap>
+	void meld_all(std::span<Heap> heaps, unsigned threads = 1) {
+		pairwise_reduce(heaps.size(), worker_count(threads), [&](std::size_t i, std::size_t j) {
+			heaps[i].merge(heaps[j]);
+		});
+	}
+
+	/// Convenience overload of @ref meld_all for a vector of heaps.
+	template <class Heap>
+	void meld_all(std::vector<Heap>& heaps, unsigned threads = 1) {
+		meld_all(std::span<Heap>(heaps), threads);
+	}
+
+	/**
+	 * @brief Loser tree over k sorted runs (stable: ties go to the lower run index).
+	 *
+	 * Leaves are padded to a power of two; each internal node stores the loser of its
+	 * match, so advancing the winner replays only one leaf-to-root path (log k compares).
+	 */
+	template <class T, class Comp>
+	class LoserTree {
+		std::vector<const T*> cur_;       // head of each leaf (padded leaves: cur_ == end_)
+		std::vector<const T*> end_;
+		std::vector<std::size_t> tree_;   // tree_[0] = winner, tree_[1..K) = losers
+		std::size_t leaves_ = 1;
+		Comp& cmp_;
+
+		// Whether leaf a's head is output before leaf b's head.
+		bool beats(std::size_t a, std::size_t b) const {
+			if (cur_[a] == end_[a]) return false;
+			if (cur_[b] == end_[b]) return true;
+			if (cmp_(*cur_[a], *cur_[b])) return true;
+			if (cmp_(*cur_[b], *cur_[a])) return false;
+			return a < b;
+		}
+
+	public:
+		LoserTree(std::span<const ConstView<T>> runs, Comp& cmp) : cmp_(cmp) {
+			while (leaves_ < runs.size()) leaves_ *= 2;
+			cur_.assign(leaves_, nullptr);
+			end_.assign(leaves_, nullptr);
+			for (std::size_t i = 0; i < runs.size(); ++i) {
+				cur_[i] = runs[i].data();
+				end_[i] = runs[i].data() + runs[i].size();
+			}
+			tree_.assign(leaves_, 0);
+			std::vector<std::size_t> win(2 * leaves_);
+			for (std::size_t i = 0; i < leaves_; ++i) win[leaves_ + i] = i;
+			for (std::size_t j = leaves_ - 1; j >= 1; --j) {
+				const std::size_t l = win[2 * j], r = win[2 * j + 1];
+				if (beats(l, r)) { win[j] = l; tree_[j] = r; }
+				else { win[j] = r; tree_[j] = l; }
+			}
+			tree_[0] = leaves_ > 1 ? win[1] : 0;
+		}
+
+		/// Writes the next @p n merged elements to @p out (n must not exceed the remainder).
+		void emit(T* out, std::size_t n) {
+			for (std::size_t i = 0; i < n; ++i) {
+				std::size_t w = tree_[0];
+				out[i] = *cur_[w]++;
+				for (std::size_t node = (w + leaves_) / 2; node >= 1; node /= 2) {
+					if (beats(tree_[node], w)) std::swap(tree_[node], w);
+				}
+				tree_[0] = w;
+			}
+		}
+	};
+
+	/**
+	 * @brief Stable k-way merge of sorted runs into @p out with a loser tree.
+	 *
+	 * With @p threads > 1 the output is split into parts by splitter selection: regular
+	 * samples of every run are sorted, evenly spaced samples become splitters, and each run
+	 * is cut at @c lower_bound(splitter). Every part is then merged independently into its
+	 * own slice of @p out. Keys equal to a splitter all land in the same part, so the result
+	 * is identical to the sequential merge.
+	 *
+	 * @param runs    Sorted input runs (by @p cmp).
+	 * @param out     Output, at least as large as the total input.
+	 * @param threads Worker count (0 = @c std::thread::hardware_concurrency()).
+	 * @return Number of elements written.
+	 */
+	template <class T, class Comp = std::less<T>>
+	std::size_t merge_runs(std::span<const ConstView<T>> runs, View<T> out, Comp cmp = Comp{}, unsigned threads = 1) {
+		std::size_t total = 0;
+		for (const auto& r : runs) total += r.size();
+		assert(out.size() >= total && "merge_runs(): output span too small");
+		threads = worker_count(threads);
+		const std::size_t parts = std::min<std::size_t>(threads, std::max<std::size_t>(1, total / 4096));
+
+		if (parts <= 1) {
+			LoserTree<T, Comp> lt(runs, cmp);
+			lt.emit(out.data(), total);
+			return total;
+		}
+
+		// Splitter selection from regular samples (about 8 per part per run).
+		std::vector<T> sample;
+		for (const auto& r : runs) {
+			const std::size_t step = std::max<std::size_t>(1, r.size() / (8 * parts));
+			for (std::size_t i = step / 2; i < r.size(); i += step) sample.push_back(r[i]);
+		}
+		std::sort(sample.begin(), sample.end(), cmp);
+
+		// cut[p][r] = start of part p in run r; cut[parts][r] = run end
+		std::vector<std::vector<std::size_t>> cut(parts + 1, std::vector<std::size_t>(runs.size(), 0));
+		for (std::size_t r = 0; r < runs.size(); ++r) cut[parts][r] = runs[r].size();
+		for (std::size_t p = 1; p < parts; ++p) {
+			const T& s = sample[p * sample.size() / parts];
+			for (std::size_t r = 0; r < runs.size(); ++r) {
+				cut[p][r] = static_cast<std::size_t>(std::lower_bound(runs[r].begin(), runs[r].end(), s, cmp) - runs[r].begin());
+			}
+		}
+		std::vector<std::size_t> offset(parts + 1, 0);
+		for (std::size_t p = 0; p < parts; ++p) {
+			std::size_t len = 0;
+			for (std::size_t r = 0; r < runs.size(); ++r) len += cut[p + 1][r] - cut[p][r];
+			offset[p + 1] = offset[p] + len;
+		}
+
+		parallel_for(parts, threads, [&](std::size_t p) {
+			std::vector<ConstView<T>> sub(runs.size());
+			for (std::size_t r = 0; r < runs.size(); ++r) sub[r] = runs[r].subspan(cut[p][r], cut[p + 1][r] - cut[p][r]);
+			Comp local = cmp;
+			LoserTree<T, Comp> lt(std::span<const ConstView<T>>(sub), local);
+			lt.emit(out.data() + offset[p], offset[p + 1] - offset[p]);
+		});
+		return total;
+	}
+
+} // namespace kj::detail
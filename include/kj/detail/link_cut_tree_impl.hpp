@@ -0,0 +1,260 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <kj/detail/config.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Link-cut tree (splay-based) for fully dynamic forest connectivity.
+	 *
+	 * Maintains a forest over vertices {0..n-1} under edge insertions (@ref link) and
+	 * deletions (@ref cut), answering @ref connected and, when a value type is given,
+	 * path aggregates (@ref path_aggregate) in O(log n) amortized time.
+	 *
+	 * Nodes live in an index arena (one contiguous vector of records, values and aggregates
+	 * inline); index 0 is a null sentinel, vertex v is stored at v+1. @ref connected and the
+	 * cycle check in @ref link compare two accesses instead of walking to the roots, and
+	 * @ref cut does not reroot the tree.
+	 *
+	 * Throughput (bench_link_cut_tree, random forests, mixed link/cut/connected): about
+	 * 3e7 ops/s at 10^3 vertices, 6e6 at 10^4, 2e6 at 10^5 and 4-5e5 at 10^6. Beyond cache
+	 * size every splay rotation is a dependent memory access, so ~10^7 ops/s is reached
+	 * only by forests of a few thousand vertices.
+	 *
+	 * @tparam T  Vertex value type, or @c void (default) to disable path aggregates.
+	 * @tparam Op Associative and commutative combine operation with identity passed to the
+	 *            constructor. Commutativity is required because @ref make_root reverses paths.
+	 */
+	template <class T = void, class Op = std::plus<>>
+	class LinkCutTree {
+	public:
+		/// True if vertex values and path aggregates are maintained.
+		static constexpr bool has_value = !std::is_void_v<T>;
+
+	private:
+		using Value = std::conditional_t<has_value, T, char>;
+
+		// Vertex value and splay-subtree aggregate, stored inline so a rotation touches one
+		// record per node; empty (no storage) without values.
+		template <bool HasValue, class = void>
+		struct NodeValues {};
+		template <class Dummy>
+		struct NodeValues<true, Dummy> { Value val{}, agg{}; };
+
+		/**
+		 * @brief Internal node record (children, path-parent/parent, lazy reversal, values).
+		 */
+		struct Node : NodeValues<has_value> {
+			int  ch[2] = { 0, 0 };
+			int  par = 0;
+			bool rev = false;
+		};
+
+		std::vector<Node> t_;
+		KJ_NO_UNIQUE_ADDRESS Op op_{};
+		Value id_{};
+
+		// ---- splay tree helpers -------------------------------------------------
+		bool is_root(int x) const noexcept {
+			const int p = t_[x].par;
+			return p == 0 || (t_[p].ch[0] != x && t_[p].ch[1] != x);
+		}
+		void push(int x) noexcept {
+			if (!t_[x].rev) return;
+			std::swap(t_[x].ch[0], t_[x].ch[1]);
+			t_[t_[x].ch[0]].rev ^= true;
+			t_[t_[x].ch[1]].rev ^= true;
+			t_[x].rev = false;
+			t_[0].rev = false;   // keep sentinel clean
+		}
+		void pull(int x) {
+			if constexpr (has_value) {
+				Node& n = t_[x];
+				n.agg = op_(op_(t_[n.ch[0]].agg, n.val), t_[n.ch[1]].agg);
+			}
+		}
+		// Rotates x above its parent; pulls only the parent (x is pulled once splay ends).
+		void rotate(int x) {
+			const int p = t_[x].par, g = t_[p].par;
+			const int d = (t_[p].ch[1] == x);
+			const int b = t_[x].ch[d ^ 1];
+			if (!is_root(p)) t_[g].ch[t_[g].ch[1] == p] = x;
+			t_[x].par = g;
+			t_[x].ch[d ^ 1] = p; t_[p].par = x;
+			t_[p].ch[d] = b; if (b) t_[b].par = p;
+			pull(p);
+		}
+		// Pending reversals are pushed only on the nodes being rotated (grandparent, parent,
+		// x in that order): rotations commute with mirroring, so flags still pending higher up
+		// stay valid and no top-down pass over the splay path is needed.
+		void splay(int x) {
+			while (!is_root(x)) {
+				const int p = t_[x].par, g = t_[p].par;
+				const bool zig = is_root(p);
+				if (!zig) push(g);
+				push(p);
+				push(x);
+				if (!zig) rotate((t_[g].ch[1] == p) == (t_[p].ch[1] == x) ? p : x);
+				rotate(x);
+			}
+			push(x);
+			pull(x);
+		}
+		// Makes the root-to-x path preferred and x the root of its splay tree. Returns the
+		// last node splayed, i.e. where the path joined the previous root path (LCA queries).
+		int access(int x) {
+			int last = 0;
+			for (int y = x; y; last = y, y = t_[y].par) {
+				splay(y);
+				t_[y].ch[1] = last;
+				pull(y);
+			}
+			splay(x);
+			return last;
+		}
+		void evert(int x) {
+			access(x);
+			t_[x].rev ^= true;
+		}
+		// After access(u), u is connected to v iff access(v) ends on u or moves u off the
+		// top of the root path (u then has a parent or path-parent link).
+		bool connected_after_access(int u, int v) {
+			return access(v) == u || t_[u].par != 0;
+		}
+		int root_of(int x) {
+			access(x);
+			for (push(x); t_[x].ch[0]; push(x)) x = t_[x].ch[0];
+			splay(x);
+			return x;
+		}
+
+		// Removes edge (c, p) if p is the parent of c under the current root; no evert, so no
+		// reversal is left behind. After access(c) the root path ends in c, and p is c's
+		// parent iff, splayed to the top of that path, its right subtree is exactly {c}.
+		bool cut_from_parent(int c, int p) {
+			access(c);
+			splay(p);
+			if (t_[p].ch[1] != c || t_[c].ch[0] != 0 || t_[c].ch[1] != 0) return false;
+			t_[p].ch[1] = 0;
+			t_[c].par = 0;
+			pull(p);
+			return true;
+		}
+
+	public:
+		//-------------------------------------------------------------------------
+		// Construction
+		//-------------------------------------------------------------------------
+
+		/**
+		 * @brief Constructs a forest of @p n isolated vertices.
+		 *
+		 * @param n        Number of vertices.
+		 * @param identity Identity element of @p Op (ignored when @p T is void).
+		 * @param op       Combine operation.
+		 */
+		explicit LinkCutTree(int n = 0, Value identity = Value{}, Op op = Op{})
+			: op_(std::move(op)), id_(std::move(identity)) {
+			reset(n);
+		}
+
+		/**
+		 * @brief Resets to @p n isolated vertices (values set to the identity).
+		 */
+		void reset(int n) {
+			t_.assign(static_cast<std::size_t>(n) + 1, Node{});
+			if constexpr (has_value) {
+				for (Node& x : t_) x.val = x.agg = id_;
+			}
+		}
+
+		/**
+		 * @brief Returns the number of vertices.
+		 */
+		[[nodiscard]] std::size_t universe() const noexcept { return t_.size() - 1; }
+
+		//-------------------------------------------------------------------------
+		// Forest operations
+		//-------------------------------------------------------------------------
+
+		/**
+		 * @brief Adds edge (@p u, @p v).
+		 * @return @c true if linked, @c false if @p u and @p v were already connected.
+		 */
+		bool link(int u, int v) {
+			if (u == v) return false;
+			++u; ++v;
+			evert(u);
+			if (connected_after_access(u, v)) return false;
+			t_[u].par = v;
+			return true;
+		}
+
+		/**
+		 * @brief Removes edge (@p u, @p v).
+		 * @return @c true if the edge existed and was removed, @c false otherwise.
+		 */
+		bool cut(int u, int v) {
+			++u; ++v;
+			return cut_from_parent(u, v) || cut_from_parent(v, u);
+		}
+
+		/**
+		 * @brief Checks whether @p u and @p v are in the same tree.
+		 */
+		bool connected(int u, int v) {
+			if (u == v) return true;
+			access(u + 1);
+			return connected_after_access(u + 1, v + 1);
+		}
+
+		/**
+		 * @brief Returns the current root of the tree containing @p x.
+		 */
+		int find_root(int x) { return root_of(x + 1) - 1; }
+
+		/**
+		 * @brief Makes @p x the root of its tree.
+		 */
+		void make_root(int x) { evert(x + 1); }
+
+		//-------------------------------------------------------------------------
+		// Values (only when T is not void)
+		//-------------------------------------------------------------------------
+
+		/**
+		 * @brief Sets the value of vertex @p x.
+		 */
+		template <class U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+		void set(int x, U v) {
+			++x;
+			access(x);
+			t_[x].val = std::move(v);
+			pull(x);
+		}
+
+		/**
+		 * @brief Returns the value of vertex @p x.
+		 */
+		template <class U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+		[[nodiscard]] const U& get(int x) const { return t_[x + 1].val; }
+
+		/**
+		 * @brief Combines the values on the path between @p u and @p v (inclusive).
+		 *
+		 * The vertices must be connected; otherwise the result is unspecified.
+		 */
+		template <class U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+		U path_aggregate(int u, int v) {
+			++u; ++v;
+			evert(u);
+			access(v);
+			return t_[v].agg;
+		}
+	};
+
+} // namespace kj::detail
@@ -0,0 +1,189 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+#include <kj/detail/buffer_vector.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Array-based min-max heap (double-ended priority queue).
+	 *
+	 * Levels alternate between "min" levels (even depth, root included) and "max" levels:
+	 * every node on a min level precedes its whole subtree under @p Comp, every node on a
+	 * max level follows it. The first element is therefore the root and the last one is
+	 * the larger of the root's children, so both ends are O(1) to read and O(log n) to
+	 * remove. Storage is one growable kj::Buffer-backed array.
+	 *
+	 * The comparator follows the kj heap convention: with @p std::less<T> (default)
+	 * @ref top_min is the smallest element and @ref top_max the largest.
+	 *
+	 * @tparam T    Key type.
+	 * @tparam Comp Comparator (StrictWeakOrder), defaults to @c std::less<T>.
+	 */
+	template <class T, class Comp = std::less<T>>
+	class MinMaxHeap {
+		BufferVector<T> a_;
+		[[no_unique_address]] Comp cmp_{};
+
+		static bool on_min_level(std::size_t i) noexcept {
+			return (std::bit_width(i + 1) & 1) != 0;   // depth = bit_width(i+1) - 1
+		}
+
+		// Order used on min levels (Max = false) or max levels (Max = true).
+		template <bool Max>
+		bool before(const T& x, const T& y) const { return Max ? cmp_(y, x) : cmp_(x, y); }
+
+		template <bool Max>
+		void bubble_up_(std::size_t i) {
+			while (i >= 3) {
+				const std::size_t g = (i - 3) / 4;
+				if (!before<Max>(a_[i], a_[g])) break;
+				std::swap(a_[i], a_[g]);
+				i = g;
+			}
+		}
+
+		void bubble_up(std::size_t i) {
+			if (i == 0) return;
+			const std::size_t p = (i - 1) / 2;
+			if (on_min_level(i)) {
+				if (cmp_(a_[p], a_[i])) { std::swap(a_[i], a_[p]); bubble_up_<true>(p); }
+				else bubble_up_<false>(i);
+			}
+			else {
+				if (cmp_(a_[i], a_[p])) { std::swap(a_[i], a_[p]); bubble_up_<false>(p); }
+				else bubble_up_<true>(i);
+			}
+		}
+
+		template <bool Max>
+		void trickle_down_(std::size_t i) {
+			const std::size_t n = a_.size();
+			for (;;) {
+				const std::size_t c = 2 * i + 1;
+				if (c >= n) return;
+				// best among children and grandchildren (indices c, c+1, 2c+1 .. 2c+4)
+				std::size_t m = c;
+				if (c + 1 < n && before<Max>(a_[c + 1], a_[m])) m = c + 1;
+				const std::size_t g = 2 * c + 1;
+				for (std::size_t j = g; j < g + 4 && j < n; ++j) if (before<Max>(a_[j], a_[m])) m = j;
+				if (!before<Max>(a_[m], a_[i])) return;
+				std::swap(a_[m], a_[i]);
+				if (m < g) return;   // child: its subtree has no further levels to fix
+				const std::size_t p = (m - 1) / 2;
+				if (before<Max>(a_[p], a_[m])) std::swap(a_[p], a_[m]);
+				i = m;
+			}
+		}
+
+		void trickle_down(std::size_t i) {
+			if (on_min_level(i)) trickle_down_<false>(i);
+			else trickle_down_<true>(i);
+		}
+
+		std::size_t max_index() const noexcept {
+			const std::size_t n = a_.size();
+			if (n <= 2) return n - 1;
+			return cmp_(a_[1], a_[2]) ? 2 : 1;
+		}
+
+		void remove_at(std::size_t i) {
+			const std::size_t last = a_.size() - 1;
+			if (i != last) a_[i] = std::move(a_[last]);
+			a_.pop_back();
+			if (i < a_.size()) trickle_down(i);
+		}
+
+		void heapify_() {
+			for (std::size_t i = a_.size() / 2; i-- > 0; ) trickle_down(i);
+		}
+
+	public:
+		//-------------------------------------------------------------------------
+		// Construction
+		//-------------------------------------------------------------------------
+
+		/// Constructs an empty heap.
+		MinMaxHeap() = default;
+
+		/// Constructs an empty heap with a custom comparator.
+		explicit MinMaxHeap(const Comp& c) : cmp_(c) {}
+
+		/**
+		 * @brief Builds a heap from [@p first, @p last) bottom-up in O(n).
+		 */
+		template <class It, class = std::enable_if_t<
+			std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>>>
+		MinMaxHeap(It first, It last, const Comp& c = Comp{}) : cmp_(c) {
+			push_range(first, last);
+		}
+
+		MinMaxHeap(MinMaxHeap&&) noexcept = default;
+		MinMaxHeap& operator=(MinMaxHeap&&) noexcept = default;
+
+		//-------------------------------------------------------------------------
+		// Observers
+		//-------------------------------------------------------------------------
+
+		[[nodiscard]] bool empty() const noexcept { return a_.empty(); }
+		[[nodiscard]] std::size_t size() const noexcept { return a_.size(); }
+		[[nodiscard]] const Comp& comparator() const noexcept { return cmp_; }
+
+		/// @return First element under @p Comp (the minimum for std::less). @pre !empty()
+		[[nodiscard]] const T& top_min() const noexcept { return a_[0]; }
+
+		/// @return Last element under @p Comp (the maximum for std::less). @pre !empty()
+		[[nodiscard]] const T& top_max() const noexcept { return a_[max_index()]; }
+
+		//-------------------------------------------------------------------------
+		// Modifiers
+		//-------------------------------------------------------------------------
+
+		void push(const T& v) { emplace(v); }
+		void push(T&& v) { emplace(std::move(v)); }
+
+		template <class... Args>
+		void emplace(Args&&... args) {
+			a_.emplace_back(std::forward<Args>(args)...);
+			bubble_up(a_.size() - 1);
+		}
+
+		/**
+		 * @brief Inserts [@p first, @p last); rebuilds bottom-up when the batch is large.
+		 */
+		template <class It>
+		void push_range(It first, It last) {
+			const auto k = static_cast<std::size_t>(std::distance(first, last));
+			a_.reserve(a_.size() + k);
+			const bool bulk = k > a_.size() / 4;
+			for (; first != last; ++first) {
+				a_.emplace_back(*first);
+				if (!bulk) bubble_up(a_.size() - 1);
+			}
+			if (bulk) heapify_();
+		}
+
+		/// Removes the first element. @pre !empty()
+		void pop_min() {
+			assert(!a_.empty() && "MinMaxHeap::pop_min(): empty heap");
+			remove_at(0);
+		}
+
+		/// Removes the last element. @pre !empty()
+		void pop_max() {
+			assert(!a_.empty() && "MinMaxHeap::pop_max(): empty heap");
+			remove_at(max_index());
+		}
+
+		/// Removes all elements (keeps the storage).
+		void clear() noexcept { a_.clear(); }
+
+		void reserve(std::size_t n) { a_.reserve(n); }
+	};
+
+} // namespace kj::detail
@@ -0,0 +1,243 @@
+#pragma once
+#include <span>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <kj/detail/dary_heap_impl.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Operation counters of a @ref MultiQueue (summed over finished handles).
+	 */
+	struct MultiQueueStats {
+		std::uint64_t pushes = 0;          ///< Successful pushes.
+		std::uint64_t pops = 0;            ///< Successful pops.
+		std::uint64_t empty_pops = 0;      ///< try_pop calls that found every queue empty.
+		std::uint64_t lock_failures = 0;   ///< Failed try-locks (contention indicator).
+	};
+
+	/**
+	 * @brief Relaxed concurrent priority queue (MultiQueue).
+	 *
+	 * Holds @c c * threads sequential heaps, each guarded by its own try-lock. A push goes
+	 * to a random unlocked queue; a pop compares the cached tops of two random queues and
+	 * takes the better one. Pops are therefore not strictly ordered: the expected rank
+	 * error is O(c * threads), see @ref rank_errors to measure it.
+	 *
+	 * Threads operate through a @ref Handle, which carries a private random state and
+	 * operation counters that are added to @ref stats when the handle is destroyed.
+	 *
+	 * The cached top of each queue is read without taking its lock, so @p T must be
+	 * trivially copyable (use a small struct or a packed integer rather than std::pair).
+	 *
+	 * @tparam T    Element type (trivially copyable).
+	 * @tparam Comp Comparator (StrictWeakOrder), defaults to @c std::less<T>.
+	 * @tparam Heap Sequential heap with push/top/pop/empty/size (default: 8-ary DaryHeap).
+	 */
+	template <class T, class Comp = std::less<T>, class Heap = DaryHeap<T, Comp, 8>>
+	class MultiQueue {
+		static_assert(std::is_trivially_copyable_v<T>, "MultiQueue: T must be trivially copyable");
+
+		// One cache line per lock/cached-top pair to avoid false sharing between queues.
+		struct alignas(64) Slot {
+			std::atomic<bool> locked{ false };
+			std::atomic<std::size_t> size{ 0 };
+			std::atomic<T> top{};
+			Heap heap;
+
+			bool try_lock() noexcept {
+				return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+			}
+			void lock() noexcept {
+				while (!try_lock()) std::this_thread::yield();
+			}
+			// Publishes size/top and releases the lock.
+			void unlock() noexcept {
+				const std::size_t n = heap.size();
+				if (n) top.store(heap.top(), std::memory_order_relaxed);
+				size.store(n, std::memory_order_relaxed);
+				locked.store(false, std::memory_order_release);
+			}
+		};
+
+		std::unique_ptr<Slot[]> slots_;
+		std::size_t n_ = 0;
+		[[no_unique_address]] Comp cmp_{};
+
+		std::atomic<std::uint64_t> pushes_{ 0 }, pops_{ 0 }, empty_pops_{ 0 }, lock_failures_{ 0 };
+
+	public:
+		/**
+		 * @brief Per-thread access point (not thread-safe itself; one per thread).
+		 */
+		class Handle {
+			MultiQueue* q_;
+			std::uint64_t rng_;
+			MultiQueueStats local_{};
+
+			std::size_t pick() noexcept {   // xorshift64*
+				rng_ ^= rng_ >> 12; rng_ ^= rng_ << 25; rng_ ^= rng_ >> 27;
+				return static_cast<std::size_t>(((rng_ * 0x2545F4914F6CDD1Dull) >> 32) % q_->n_);
+			}
+
+		public:
+			Handle(MultiQueue& q, std::uint64_t seed) noexcept
+				: q_(&q), rng_(seed * 0x9E3779B97F4A7C15ull | 1) {}
+
+			Handle(const Handle&) = delete;
+			Handle& operator=(const Handle&) = delete;
+			Handle(Handle&& o) noexcept : q_(o.q_), rng_(o.rng_), local_(o.local_) { o.q_ = nullptr; }
+
+			~Handle() { flush(); }
+
+			/// Adds the local counters to the queue totals and zeroes them.
+			void flush() noexcept {
+				if (!q_) return;
+				q_->pushes_.fetch_add(local_.pushes, std::memory_order_relaxed);
+				q_->pops_.fetch_add(local_.pops, std::memory_order_relaxed);
+				q_->empty_pops_.fetch_add(local_.empty_pops, std::memory_order_relaxed);
+				q_->lock_failures_.fetch_add(local_.lock_failures, std::memory_order_relaxed);
+				local_ = MultiQueueStats{};
+			}
+
+			/// @return Counters of this handle not yet flushed.
+			[[nodiscard]] const MultiQueueStats& stats() const noexcept { return local_; }
+
+			/// Inserts @p v into a random queue.
+			void push(const T& v) {
+				for (;;) {
+					Slot& s = q_->slots_[pick()];
+					if (!s.try_lock()) { ++local_.lock_failures; continue; }
+					s.heap.push(v);
+					s.unlock();
+					++local_.pushes;
+					return;
+				}
+			}
+
+			/**
+			 * @brief Removes a near-minimal element into @p out.
+			 *
+			 * Tries a few two-choice pops, then sweeps all queues. Returns false if every
+			 * queue was empty when visited (concurrent pushes may make this spurious).
+			 */
+			bool try_pop(T& out) {
+				const std::size_t n = q_->n_;
+				for (int attempt = 0; attempt < 8; ++attempt) {
+					std::size_t i = pick(), j = pick();
+					const std::size_t ni = q_->slots_[i].size.load(std::memory_order_relaxed);
+					const std::size_t nj = q_->slots_[j].size.load(std::memory_order_relaxed);
+					if (!ni && !nj) continue;
+					if (!ni || (nj && q_->cmp_(q_->slots_[j].top.load(std::memory_order_relaxed),
+						q_->slots_[i].top.load(std::memory_order_relaxed)))) i = j;
+					Slot& s = q_->slots_[i];
+					if (!s.try_lock()) { ++local_.lock_failures; continue; }
+					if (s.heap.empty()) { s.unlock(); continue; }
+					out = s.heap.top();
+					s.heap.pop();
+					s.unlock();
+					++local_.pops;
+					return true;
+				}
+				const std::size_t start = pick();
+				for (std::size_t k = 0; k < n; ++k) {
+					Slot& s = q_->slots_[(start + k) % n];
+					if (!s.size.load(std::memory_order_relaxed)) continue;
+					s.lock();
+					if (!s.heap.empty()) {
+						out = s.heap.top();
+						s.heap.pop();
+						s.unlock();
+						++local_.pops;
+						return true;
+					}
+					s.unlock();
+				}
+				++local_.empty_pops;
+				return false;
+			}
+		};
+
+		/**
+		 * @brief Creates @p c * @p threads queues (at least one).
+		 *
+		 * @param threads Expected number of concurrent handles (0 = hardware concurrency).
+		 * @param c       Queues per thread; larger values reduce contention, raise rank error.
+		 */
+		explicit MultiQueue(unsigned threads = 0, unsigned c = 2, const Comp& cmp = Comp{})
+			: cmp_(cmp) {
+			if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+			n_ = std::max<std::size_t>(1, std::size_t{ threads } * c);
+			slots_ = std::make_unique<Slot[]>(n_);
+		}
+
+		MultiQueue(const MultiQueue&) = delete;
+		MultiQueue& operator=(const MultiQueue&) = delete;
+
+		/// Returns a handle seeded with @p seed (use a distinct seed per thread).
+		[[nodiscard]] Handle handle(std::uint64_t seed) { return Handle(*this, seed); }
+
+		/// @return Number of internal queues.
+		[[nodiscard]] std::size_t queues() const noexcept { return n_; }
+
+		/// @return Approximate element count (exact when no operation is in flight).
+		[[nodiscard]] std::size_t size() const noexcept {
+			std::size_t s = 0;
+			for (std::size_t i = 0; i < n_; ++i) s += slots_[i].size.load(std::memory_order_relaxed);
+			return s;
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+		/// @return Counters of all destroyed (or flushed) handles.
+		[[nodiscard]] MultiQueueStats stats() const noexcept {
+			return { pushes_.load(std::memory_order_relaxed), pops_.load(std::memory_order_relaxed),
+				empty_pops_.load(std::memory_order_relaxed), lock_failures_.load(std::memory_order_relaxed) };
+		}
+	};
+
+	/**
+	 * @brief Summary returned by @ref rank_errors.
+	 */
+	struct RankErrorStats {
+		double mean = 0;        ///< Average rank error per pop.
+		std::size_t max = 0;    ///< Largest rank error observed.
+	};
+
+	/**
+	 * @brief Rank errors of a pop sequence recorded while draining a queue (no pushes).
+	 *
+	 * The rank error of pop @c i is the number of elements popped after it that compare
+	 * strictly better, i.e. how many better elements were still queued; 0 for an exact
+	 * priority queue. O(n log n) with a Fenwick tree.
+	 */
+	template <class T, class Comp = std::less<T>>
+	RankErrorStats rank_errors(std::span<const T> pops, Comp cmp = Comp{}) {
+		RankErrorStats r;
+		if (pops.empty()) return r;
+		std::vector<T> keys(pops.begin(), pops.end());
+		std::sort(keys.begin(), keys.end(), cmp);
+		keys.erase(std::unique(keys.begin(), keys.end(),
+			[&](const T& a, const T& b) { return !cmp(a, b) && !cmp(b, a); }), keys.end());
+		std::vector<std::size_t> fen(keys.size() + 1, 0);
+		double sum = 0;
+		for (std::size_t i = pops.size(); i-- > 0; ) {
+			const auto rk = static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), pops[i], cmp) - keys.begin());
+			std::size_t better = 0;
+			for (std::size_t k = rk; k > 0; k &= k - 1) better += fen[k];
+			for (std::size_t k = rk + 1; k < fen.size(); k += k & (~k + 1)) ++fen[k];
+			sum += static_cast<double>(better);
+			r.max = std::max(r.max, better);
+		}
+		r.mean = sum / static_cast<double>(pops.size());
+		return r;
+	}
+
+} // namespace kj::detail
@@ -5,6 +5,7 @@
 #include <utility>
 #include <algorithm>
 #include <cassert>
+#include <type_traits>
 
 namespace kj::detail {
 
@@ -15,6 +16,9 @@ namespace kj::detail {
 	 * node-like objects. It does not call constructors at block allocation time;
 	 * objects are constructed with placement-new in @ref create and destroyed in @ref destroy.
 	 *
+	 * Fresh slots are handed out by bumping a cursor through the blocks; destroyed slots go
+	 * to a free-list that is served first. This makes @ref reset O(1).
+	 *
 	 * @tparam T Object type managed by this pool.
 	 *
 	 * @note All outstanding objects must be destroyed before calling @ref release_all.
@@ -39,12 +43,12 @@ namespace kj::detail {
 
 		/**
 		 * @brief Ensures at least @p n free slots are available.
-		 *        Allocates one or more blocks and pushes their slots to the free-list.
+		 *        Allocates one or more blocks if the free-list and untouched slots are not enough.
 		 */
 		void reserve(std::size_t n) {
-			if (free_.size() >= n) return;
-			const std::size_t need = n - free_.size();
-			grow_(need);
+			const std::size_t avail = free_.size() + untouched_;
+			if (avail >= n) return;
+			grow_(n - avail);
 		}
 
 		/**
@@ -52,13 +56,36 @@ namespace kj::detail {
 		 */
 		template <class... Args>
 		T* create(Args&&... args) {
-			if (free_.empty()) grow_(1);
-			T* p = free_.back(); free_.pop_back();
+			T* p;
+			if (!free_.empty()) { p = free_.back(); free_.pop_back(); }
+			else p = bump_();
 			::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
 			++live_;
 			return p;
 		}
 
+		/**
+		 * @brief Hands out @p n contiguous, uninitialized slots (counted as live objects).
+		 *
+		 * The caller constructs each slot with placement-new and later releases it with
+		 * @ref destroy as usual. Leftover slots of blocks too small for the run are moved to
+		 * the free-list, so nothing is wasted.
+		 */
+		T* allocate_run(std::size_t n) {
+			if (n == 0) return nullptr;
+			while (cur_ < blocks_.size() && blocks_[cur_].count - used_ < n) {
+				for (std::size_t i = used_; i < blocks_[cur_].count; ++i) free_.push_back(blocks_[cur_].ptr + i);
+				untouched_ -= blocks_[cur_].count - used_;
+				++cur_; used_ = 0;
+			}
+			if (cur_ == blocks_.size()) grow_(n);
+			T* p = blocks_[cur_].ptr + used_;
+			used_ += n;
+			untouched_ -= n;
+			live_ += n;
+			return p;
+		}
+
 		/**
 		 * @brief Destroys the object and returns its slot to the free-list.
 		 */
@@ -69,6 +96,50 @@ namespace kj::detail {
 			--live_;
 		}
 
+		/**
+		 * @brief Returns a slot that was never constructed (e.g. from @ref allocate_run).
+		 */
+		void deallocate(T* p) noexcept {
+			if (!p) return;
+			free_.push_back(p);
+			--live_;
+		}
+
+		/**
+		 * @brief Destroys @p n objects linked by @p next (head first) and frees their slots.
+		 *
+		 * Same as calling @ref destroy on each, with the free-list grown once for the batch.
+		 * @p next must read the link before the object is destroyed; it is called on each
+		 * object, which is destroyed right after.
+		 */
+		template <class Next>
+		void destroy_list(T* head, std::size_t n, Next next) {
+			free_.reserve(free_.size() + n);
+			live_ -= n;
+			for (; n > 0; --n) {
+				T* p = head;
+				head = next(p);
+				p->~T();
+				free_.push_back(p);
+			}
+		}
+
+		/**
+		 * @brief Marks every slot free in O(1) without running destructors; keeps the blocks.
+		 *
+		 * All outstanding pointers become dangling. Only available for trivially
+		 * destructible @p T, where skipping the destructors is not observable.
+		 */
+		void reset() noexcept {
+			static_assert(std::is_trivially_destructible_v<T>,
+				"ObjectPool::reset() requires a trivially destructible T");
+			free_.clear();
+			cur_ = 0;
+			used_ = 0;
+			untouched_ = block_slots_;
+			live_ = 0;
+		}
+
 		/**
 		 * @brief Releases all blocks back to the OS.
 		 *
@@ -84,6 +155,10 @@ namespace kj::detail {
 			}
 			blocks_.clear();
 			free_.clear();
+			cur_ = 0;
+			used_ = 0;
+			untouched_ = 0;
+			block_slots_ = 0;
 			// keep next_block_cap_ as-is to preserve growth pattern on re-use
 		}
 
@@ -100,20 +175,31 @@ namespace kj::detail {
 		};
 
 		std::vector<Block> blocks_;   // raw memory blocks of T slots (uninitialized)
-		std::vector<T*>    free_;     // free-list of available slots
+		std::vector<T*>    free_;     // free-list of recycled slots
+		std::size_t        cur_ = 0;          // block currently served by the bump cursor
+		std::size_t        used_ = 0;         // slots bumped so far in blocks_[cur_]
+		std::size_t        untouched_ = 0;    // slots never handed out since the last reset
+		std::size_t        block_slots_ = 0;  // slots in currently owned blocks
 		std::size_t        next_block_cap_ = 4096;
 		std::size_t        total_slots_ = 0;
 		std::size_t        live_ = 0;
 
+		T* bump_() {
+			while (cur_ < blocks_.size() && used_ == blocks_[cur_].count) { ++cur_; used_ = 0; }
+			if (cur_ == blocks_.size()) grow_(1);
+			--untouched_;
+			return blocks_[cur_].ptr + used_++;
+		}
+
 		void grow_(std::size_t min_new_slots) {
 			// Allocate enough blocks to satisfy min_new_slots, with geometric growth.
 			while (min_new_slots > 0) {
 				const std::size_t count = std::max(next_block_cap_, min_new_slots);
 				T* mem = static_cast<T*>(::operator new[](sizeof(T)* count, std::align_val_t{ alignof(T) }));
 				blocks_.push_back(Block{ mem, count });
-				// push each slot to the free list (no construction yet)
-				for (std::size_t i = 0; i < count; ++i) free_.push_back(mem + i);
 				total_slots_ += count;
+				block_slots_ += count;
+				untouched_ += count;
 				min_new_slots = (min_new_slots > count ? min_new_slots - count : 0);
 				// next block grows geometrically
 				if (next_block_cap_ < (static_cast<std::size_t>(1) << 28)) next_block_cap_ *= 2;
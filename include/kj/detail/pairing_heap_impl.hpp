@@ -0,0 +1,298 @@
+#pragma once
+#include <utility>
+#include <cstddef>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <kj/detail/object_pool.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Pairing heap (mergeable heap) with pooled nodes and stable handles.
+	 *
+	 * Same interface as @ref AddressableSkewHeap: @ref push / @ref emplace return a
+	 * @ref handle for @ref decrease_key and @ref erase; @ref merge melds two heaps.
+	 * push, merge and decrease_key are O(1) (a single link); pop uses the standard
+	 * two-pass pairing of the root's children (O(log n) amortized), done iteratively.
+	 *
+	 * Children are kept in a doubly-linked sibling list: @c prev points to the previous
+	 * sibling, or to the parent for the first child.
+	 *
+	 * Nodes come from an @ref ObjectPool that is either owned (created on first use) or
+	 * shared by reference between heaps.
+	 *
+	 * @tparam T    Key type.
+	 * @tparam Comp Comparator (StrictWeakOrder), defaults to @c std::less<T> (min-heap).
+	 */
+	template <class T, class Comp = std::less<T>>
+	class PairingHeap {
+	private:
+		/**
+		 * @brief Internal node type.
+		 */
+		struct Node {
+			T     key;
+			Node* child;
+			Node* sibling;
+			Node* prev;
+
+			template<class U>
+			explicit Node(U&& v) : key(std::forward<U>(v)), child(nullptr), sibling(nullptr), prev(nullptr) {}
+		};
+
+		Node* root_ = nullptr;
+		std::size_t sz_ = 0;
+		[[no_unique_address]] Comp cmp_{};
+		ObjectPool<Node>* pool_ = nullptr;
+		std::unique_ptr<ObjectPool<Node>> own_;
+
+		ObjectPool<Node>& pool_ref() {
+			if (!pool_) {
+				own_ = std::make_unique<ObjectPool<Node>>();
+				pool_ = own_.get();
+			}
+			return *pool_;
+		}
+
+		// Links two detached roots; the loser becomes the first child of the winner.
+		Node* link(Node* a, Node* b) {
+			if (cmp_(b->key, a->key)) std::swap(a, b);
+			b->prev = a;
+			b->sibling = a->child;
+			if (a->child) a->child->prev = b;
+			a->child = b;
+			return a;
+		}
+
+		// Two-pass pairing of a sibling list into one detached root (iterative).
+		Node* combine(Node* first) {
+			if (!first) return nullptr;
+			// pass 1: link pairs left to right, stacking results through 'sibling'
+			Node* pairs = nullptr;
+			while (first) {
+				Node* a = first;
+				Node* b = a->sibling;
+				if (!b) { a->sibling = pairs; pairs = a; break; }
+				first = b->sibling;
+				a->sibling = b->sibling = nullptr;
+				a = link(a, b);
+				a->sibling = pairs;
+				pairs = a;
+			}
+			// pass 2: link right to left into an accumulator
+			Node* res = pairs;
+			pairs = pairs->sibling;
+			res->sibling = nullptr;
+			while (pairs) {
+				Node* next = pairs->sibling;
+				pairs->sibling = nullptr;
+				res = link(res, pairs);
+				pairs = next;
+			}
+			res->prev = nullptr;
+			return res;
+		}
+
+		// Detaches non-root x (with its subtree) from its sibling list.
+		void cut(Node* x) noexcept {
+			if (x->prev->child == x) x->prev->child = x->sibling;
+			else x->prev->sibling = x->sibling;
+			if (x->sibling) x->sibling->prev = x->prev;
+			x->sibling = x->prev = nullptr;
+		}
+
+		void destroy_all() noexcept {
+			// Stack-free teardown: child/sibling form a binary tree; rotate children up.
+			Node* n = root_;
+			while (n) {
+				if (Node* c = n->child) {
+					n->child = c->sibling;
+					c->sibling = n;
+					n = c;
+				}
+				else {
+					Node* next = n->sibling;
+					pool_->destroy(n);
+					n = next;
+				}
+			}
+		}
+
+	public:
+		/// Node pool type usable for sharing one pool between heaps.
+		using pool_type = ObjectPool<Node>;
+
+		/**
+		 * @brief Stable reference to an element (valid until popped or erased).
+		 */
+		class handle {
+		public:
+			handle() = default;
+			explicit operator bool() const noexcept { return n_ != nullptr; }
+			friend bool operator==(handle a, handle b) noexcept { return a.n_ == b.n_; }
+			friend bool operator!=(handle a, handle b) noexcept { return a.n_ != b.n_; }
+
+		private:
+			friend class PairingHeap;
+			explicit handle(Node* n) noexcept : n_(n) {}
+			Node* n_ = nullptr;
+		};
+
+		//-------------------------------------------------------------------------
+		// Construction / destruction
+		//-------------------------------------------------------------------------
+
+		/// Constructs an empty heap; an own pool is created on first use.
+		PairingHeap() = default;
+
+		/// Constructs an empty heap with a custom comparator.
+		explicit PairingHeap(const Comp& c) : cmp_(c) {}
+
+		/// Constructs an empty heap allocating from the shared @p pool (must outlive the heap).
+		explicit PairingHeap(pool_type& pool, const Comp& c = Comp{}) : cmp_(c), pool_(&pool) {}
+
+		~PairingHeap() { clear(); }
+
+		PairingHeap(const PairingHeap&) = delete;
+		PairingHeap& operator=(const PairingHeap&) = delete;
+
+		// Moving keeps handles valid: nodes stay in the same (heap-allocated or shared) pool.
+		// Move assignment hands the target's previous pool binding to the source, so an
+		// owned pool other heaps may still be bound to (see @ref pool) is never destroyed.
+		PairingHeap(PairingHeap&& other) noexcept
+			: root_(other.root_), sz_(other.sz_), cmp_(std::move(other.cmp_)),
+			pool_(other.pool_), own_(std::move(other.own_)) {
+			other.root_ = nullptr; other.sz_ = 0; other.pool_ = nullptr;
+		}
+		PairingHeap& operator=(PairingHeap&& other) noexcept {
+			if (this != &other) {
+				clear();
+				root_ = other.root_; sz_ = other.sz_;
+				cmp_ = std::move(other.cmp_);
+				using std::swap;
+				swap(pool_, other.pool_);
+				swap(own_, other.own_);
+				other.root_ = nullptr; other.sz_ = 0;
+			}
+			return *this;
+		}
+
+		/// Exchanges contents (and pool bindings) with @p other in O(1).
+		void swap(PairingHeap& other) noexcept {
+			using std::swap;
+			swap(root_, other.root_);
+			swap(sz_, other.sz_);
+			swap(cmp_, other.cmp_);
+			swap(pool_, other.pool_);
+			swap(own_, other.own_);
+		}
+
+		friend void swap(PairingHeap& a, PairingHeap& b) noexcept { a.swap(b); }
+
+		//-------------------------------------------------------------------------
+		// Pool controls
+		//-------------------------------------------------------------------------
+
+		/// Pre-allocates approximately @p n node slots in the pool in use.
+		void reserve_nodes(std::size_t n) { pool_ref().reserve(n); }
+
+		/**
+		 * @brief Returns the pool in use, e.g. to bind more heaps to it.
+		 *
+		 * Heaps bound to another heap's own pool must be destroyed before that heap (or,
+		 * after a move assignment into it, before the moved-from source that now owns it).
+		 */
+		pool_type& pool() { return pool_ref(); }
+
+		//-------------------------------------------------------------------------
+		// Observers
+		//-------------------------------------------------------------------------
+
+		/// Removes all elements (O(n), stack-free). All handles become invalid.
+		void clear() noexcept {
+			if (root_) destroy_all();
+			root_ = nullptr; sz_ = 0;
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return root_ == nullptr; }
+		[[nodiscard]] std::size_t size() const noexcept { return sz_; }
+		[[nodiscard]] const T& top() const noexcept { return root_->key; }
+		[[nodiscard]] handle top_handle() const noexcept { return handle(root_); }
+		[[nodiscard]] const Comp& comparator() const noexcept { return cmp_; }
+
+		/// Returns the key referenced by @p h.
+		[[nodiscard]] const T& value(handle h) const noexcept { return h.n_->key; }
+
+		//-------------------------------------------------------------------------
+		// Modifiers
+		//-------------------------------------------------------------------------
+
+		handle push(const T& v) { return emplace(v); }
+		handle push(T&& v) { return emplace(std::move(v)); }
+
+		template<class... Args>
+		handle emplace(Args&&... args) {
+			Node* n = pool_ref().create(T(std::forward<Args>(args)...));
+			root_ = root_ ? link(root_, n) : n;
+			++sz_;
+			return handle(n);
+		}
+
+		void pop() {
+			Node* old = root_;
+			root_ = combine(old->child);
+			pool_->destroy(old);
+			--sz_;
+		}
+
+		/**
+		 * @brief Replaces the key of @p h by @p v, which must not compare worse than the old key.
+		 *
+		 * The subtree of @p h is cut from its sibling list and linked with the root (O(1)).
+		 */
+		void decrease_key(handle h, T v) {
+			Node* x = h.n_;
+			assert(!cmp_(x->key, v) && "decrease_key(): new key is worse than the old one");
+			x->key = std::move(v);
+			if (x == root_) return;
+			cut(x);
+			root_ = link(root_, x);
+		}
+
+		/**
+		 * @brief Removes the element referenced by @p h; @p h becomes invalid.
+		 */
+		void erase(handle h) {
+			Node* x = h.n_;
+			if (x == root_) { pop(); return; }
+			cut(x);
+			if (Node* c = combine(x->child)) root_ = link(root_, c);
+			pool_->destroy(x);
+			--sz_;
+		}
+
+		/**
+		 * @brief Moves all elements of @p other into this heap; @p other becomes empty.
+		 *
+		 * When both heaps share a pool the roots are linked in O(1) and handles of @p other
+		 * stay valid (now referring into this heap). Otherwise the elements are moved over
+		 * one by one and the handles of @p other are invalidated.
+		 */
+		void merge(PairingHeap& other) {
+			if (this == &other || !other.root_) return;
+			if (&pool_ref() != other.pool_) {
+				while (!other.empty()) {
+					push(std::move(other.root_->key));
+					other.pop();
+				}
+				return;
+			}
+			root_ = root_ ? link(root_, other.root_) : other.root_;
+			sz_ += other.sz_;
+			other.root_ = nullptr;
+			other.sz_ = 0;
+		}
+	};
+
+} // namespace kj::detail
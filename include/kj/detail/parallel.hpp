@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace kj::detail {
+
+	/// Resolves a worker-count argument: 0 means @c std::thread::hardware_concurrency().
+	inline unsigned worker_count(unsigned threads) noexcept {
+		return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	/**
+	 * @brief Runs @p fn(i) for i in [0, n) on up to @p threads workers (calling thread included).
+	 *
+	 * Indices are claimed one at a time from a shared counter, so uneven items balance out.
+	 * With one worker (or n <= 1) everything runs inline, in index order.
+	 */
+	template <class F>
+	void parallel_for(std::size_t n, unsigned threads, F&& fn) {
+		const unsigned workers = static_cast<unsigned>(std::min<std::size_t>(threads, n));
+		if (workers <= 1) {
+			for (std::size_t i = 0; i < n; ++i) fn(i);
+			return;
+		}
+		std::atomic<std::size_t> next{ 0 };
+		auto work = [&] {
+			for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n; ) fn(i);
+		};
+		std::vector<std::thread> pool;
+		pool.reserve(workers - 1);
+		for (unsigned w = 1; w < workers; ++w) pool.emplace_back(work);
+		work();
+		for (auto& t : pool) t.join();
+	}
+
+	/**
+	 * @brief Folds items [0, k) into item 0 along a balanced binary tree.
+	 *
+	 * Level @c s calls @p combine(i, i+s) for every @c i that is a multiple of @c 2s, so each
+	 * item takes part in O(log k) combines; the combines of one level are independent and
+	 * run through @ref parallel_for on up to @p threads workers.
+	 */
+	template <class F>
+	void pairwise_reduce(std::size_t k, unsigned threads, F&& combine) {
+		for (std::size_t step = 1; step < k; step *= 2) {
+			const std::size_t pairs = (k - step + 2 * step - 1) / (2 * step);
+			parallel_for(pairs, threads, [&](std::size_t j) {
+				const std::size_t i = j * 2 * step;
+				combine(i, i + step);
+			});
+		}
+	}
+
+} // namespace kj::detail
@@ -0,0 +1,190 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include <kj/detail/object_pool.hpp>
+#include <kj/detail/dary_heap_impl.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Append-only node arena for persistent structures.
+	 *
+	 * Nodes are never freed individually (they may be shared by many versions); @ref clear
+	 * and the destructor release all of them at once. Trivially destructible nodes are
+	 * recycled in O(1); otherwise the arena remembers every node to run its destructor.
+	 */
+	template <class Node>
+	class NodeArena {
+		ObjectPool<Node> pool_;
+		[[no_unique_address]] std::conditional_t<std::is_trivially_destructible_v<Node>, char, std::vector<Node*>> made_{};
+
+	public:
+		NodeArena() = default;
+		NodeArena(const NodeArena&) = delete;
+		NodeArena& operator=(const NodeArena&) = delete;
+		~NodeArena() { clear(); }
+
+		template <class... Args>
+		Node* make(Args&&... args) {
+			Node* n = pool_.create(std::forward<Args>(args)...);
+			if constexpr (!std::is_trivially_destructible_v<Node>) {
+				try { made_.push_back(n); }
+				catch (...) { pool_.destroy(n); throw; }
+			}
+			return n;
+		}
+
+		/// Destroys every node; all heaps built on this arena become invalid.
+		void clear() noexcept {
+			if constexpr (std::is_trivially_destructible_v<Node>) pool_.reset();
+			else {
+				for (Node* n : made_) pool_.destroy(n);
+				made_.clear();
+			}
+		}
+
+		void reserve(std::size_t n) { pool_.reserve(n); }
+
+		/// @return Number of nodes currently allocated.
+		[[nodiscard]] std::size_t size() const noexcept { return pool_.live(); }
+	};
+
+	/**
+	 * @brief Persistent (immutable) leftist heap with structural sharing.
+	 *
+	 * A heap value is a cheap handle to an immutable tree; every modifier returns a new
+	 * version and leaves the receiver untouched. Merge walks the two right spines, which a
+	 * leftist tree keeps at O(log n) worst case, and copies only the nodes on that path;
+	 * all other subtrees are shared between versions. Nodes come from a @ref NodeArena
+	 * that must outlive every version built on it.
+	 *
+	 * By default this is a min-heap via @p std::less<T>.
+	 *
+	 * @tparam T    Key type (copyable).
+	 * @tparam Comp Comparator (StrictWeakOrder), defaults to @c std::less<T>.
+	 */
+	template <class T, class Comp = std::less<T>>
+	class PersistentLeftistHeap {
+		struct Node {
+			T key;
+			const Node* left = nullptr;
+			const Node* right = nullptr;
+			std::uint32_t rank = 1;   // length of the right spine (null = 0)
+
+			template <class U>
+			explicit Node(U&& v) : key(std::forward<U>(v)) {}
+			Node(const Node&) = default;
+		};
+
+	public:
+		/// Node arena type shared by all versions of a family of heaps.
+		using arena_type = NodeArena<Node>;
+
+	private:
+		const Node* root_ = nullptr;
+		std::size_t sz_ = 0;
+		arena_type* arena_ = nullptr;
+		[[no_unique_address]] Comp cmp_{};
+
+		PersistentLeftistHeap(const Node* r, std::size_t sz, arena_type* a, const Comp& c)
+			: root_(r), sz_(sz), arena_(a), cmp_(c) {}
+
+		static std::uint32_t rank_of(const Node* n) noexcept { return n ? n->rank : 0; }
+
+		// Path-copying merge without recursion: the copied spine is at most
+		// rank(a) + rank(b) <= 2 * 64 nodes long.
+		const Node* merge_nodes(const Node* a, const Node* b) const {
+			std::array<Node*, 130> path;
+			std::size_t len = 0;
+			while (a && b) {
+				if (cmp_(b->key, a->key)) std::swap(a, b);
+				path[len++] = arena_->make(*a);
+				a = a->right;
+			}
+			const Node* child = a ? a : b;
+			while (len) {
+				Node* c = path[--len];
+				c->right = child;
+				if (rank_of(c->left) < rank_of(c->right)) std::swap(c->left, c->right);
+				c->rank = rank_of(c->right) + 1;
+				child = c;
+			}
+			return child;
+		}
+
+		struct NodeLess {
+			[[no_unique_address]] Comp cmp;
+			bool operator()(const Node* a, const Node* b) const { return cmp(a->key, b->key); }
+		};
+
+	public:
+		/// Empty heap not bound to an arena (can still be merged with and inspected).
+		PersistentLeftistHeap() = default;
+
+		/// Empty heap that allocates from @p arena.
+		explicit PersistentLeftistHeap(arena_type& arena, const Comp& c = Comp{}) : arena_(&arena), cmp_(c) {}
+
+		[[nodiscard]] bool empty() const noexcept { return root_ == nullptr; }
+		[[nodiscard]] std::size_t size() const noexcept { return sz_; }
+		[[nodiscard]] const T& top() const noexcept { return root_->key; }
+		[[nodiscard]] const Comp& comparator() const noexcept { return cmp_; }
+		[[nodiscard]] arena_type* arena() const noexcept { return arena_; }
+
+		/**
+		 * @brief Returns a version with @p v added (O(log n) new nodes).
+		 */
+		[[nodiscard]] PersistentLeftistHeap push(const T& v) const {
+			assert(arena_ && "PersistentLeftistHeap::push(): heap not bound to an arena");
+			const Node* n = arena_->make(v);
+			return PersistentLeftistHeap(merge_nodes(root_, n), sz_ + 1, arena_, cmp_);
+		}
+
+		/**
+		 * @brief Returns a version without the top element (O(log n) new nodes).
+		 */
+		[[nodiscard]] PersistentLeftistHeap pop() const {
+			assert(root_ && "PersistentLeftistHeap::pop(): empty heap");
+			return PersistentLeftistHeap(merge_nodes(root_->left, root_->right), sz_ - 1, arena_, cmp_);
+		}
+
+		/**
+		 * @brief Returns the meld of this heap and @p other (O(log n) new nodes).
+		 *
+		 * Both heaps must use the same arena (or be empty).
+		 */
+		[[nodiscard]] PersistentLeftistHeap merge(const PersistentLeftistHeap& other) const {
+			if (!other.root_) return *this;
+			if (!root_) return other;
+			assert(arena_ == other.arena_ && "PersistentLeftistHeap::merge(): different arenas");
+			return PersistentLeftistHeap(merge_nodes(root_, other.root_), sz_ + other.sz_, arena_, cmp_);
+		}
+
+		/**
+		 * @brief Writes the @p k best elements in order to @p out (O(k log k), no new nodes).
+		 *
+		 * Runs a best-first search over the tree with a frontier heap of node pointers: a
+		 * popped node's children are the only new candidates, as every parent beats its children.
+		 */
+		template <class OutIt>
+		OutIt smallest(std::size_t k, OutIt out) const {
+			if (!root_ || k == 0) return out;
+			DaryHeap<const Node*, NodeLess, 4> frontier(NodeLess{ cmp_ });
+			frontier.push(root_);
+			for (; k > 0 && !frontier.empty(); --k) {
+				const Node* n = frontier.top();
+				frontier.pop();
+				*out++ = n->key;
+				if (n->left) frontier.push(n->left);
+				if (n->right) frontier.push(n->right);
+			}
+			return out;
+		}
+	};
+
+} // namespace kj::detail
@@ -0,0 +1,125 @@
+#pragma once
+#include <bit>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <kj/detail/buffer_vector.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Monotone radix heap for unsigned integer keys (min-heap).
+	 *
+	 * Entries are kept in B + 1 buckets (B = bit width of @p Key): bucket @c i holds keys
+	 * whose highest bit differing from the last extracted minimum is bit @c i-1, bucket 0
+	 * holds keys equal to it. Extraction empties the lowest non-empty bucket, and each
+	 * entry only moves to strictly lower buckets, so push is O(1) and pop is amortized
+	 * O(log C) for a key range C.
+	 *
+	 * Pushed keys must not be smaller than the last popped key (Dijkstra-style monotone
+	 * use). Buckets are kj::Buffer-backed and keep their storage on @ref clear.
+	 *
+	 * @tparam Key   Unsigned integer key.
+	 * @tparam Value Payload stored next to the key.
+	 */
+	template <class Key, class Value>
+	class RadixHeap {
+		static_assert(std::is_unsigned_v<Key>, "RadixHeap: Key must be an unsigned integer type");
+
+	public:
+		using value_type = std::pair<Key, Value>;
+
+	private:
+		static constexpr int bits_ = std::numeric_limits<Key>::digits;
+		static_assert(bits_ <= 64, "RadixHeap: Key wider than 64 bits is not supported");
+
+		// top() may redistribute, which is not an observable change.
+		mutable BufferVector<value_type> buckets_[bits_ + 1];
+		mutable std::uint64_t nonempty_ = 0;   // bit i-1 set <=> bucket i (1..B) non-empty
+		mutable Key last_ = 0;
+		std::size_t n_ = 0;
+
+		static int bucket_of(Key k, Key last) noexcept {
+			return static_cast<int>(std::bit_width(static_cast<Key>(k ^ last)));
+		}
+
+		void put(value_type&& e) const {
+			const int b = bucket_of(e.first, last_);
+			buckets_[b].push_back(std::move(e));
+			if (b) nonempty_ |= std::uint64_t{ 1 } << (b - 1);
+		}
+
+		// Refills bucket 0 from the lowest non-empty bucket. Requires n_ > 0.
+		void pull() const {
+			if (!buckets_[0].empty()) return;
+			const int b = std::countr_zero(nonempty_) + 1;
+			auto& src = buckets_[b];
+			Key m = src[0].first;
+			for (const auto& e : src) m = e.first < m ? e.first : m;
+			last_ = m;
+			for (auto& e : src) put(std::move(e));   // every entry lands below b
+			src.clear();
+			nonempty_ &= ~(std::uint64_t{ 1 } << (b - 1));
+		}
+
+	public:
+		RadixHeap() = default;
+
+		RadixHeap(const RadixHeap&) = delete;
+		RadixHeap& operator=(const RadixHeap&) = delete;
+		RadixHeap(RadixHeap&&) noexcept = default;
+		RadixHeap& operator=(RadixHeap&&) noexcept = default;
+
+		/**
+		 * @brief Inserts @p value with priority @p key (amortized O(1)).
+		 * @pre key >= last_key()
+		 */
+		template <class... Args>
+		void emplace(Key key, Args&&... args) {
+			assert(key >= last_ && "RadixHeap::push(): key below the last extracted minimum");
+			put(value_type(std::piecewise_construct, std::forward_as_tuple(key),
+				std::forward_as_tuple(std::forward<Args>(args)...)));
+			++n_;
+		}
+
+		void push(Key key, const Value& v) { emplace(key, v); }
+		void push(Key key, Value&& v) { emplace(key, std::move(v)); }
+
+		/**
+		 * @brief Returns the entry with the smallest key (ties in unspecified order).
+		 * @pre !empty()
+		 */
+		[[nodiscard]] const value_type& top() const {
+			assert(n_ > 0 && "RadixHeap::top(): empty heap");
+			pull();
+			return buckets_[0].back();
+		}
+
+		/// Removes the entry returned by @ref top (amortized O(log C)).
+		void pop() {
+			assert(n_ > 0 && "RadixHeap::pop(): empty heap");
+			pull();
+			buckets_[0].pop_back();
+			--n_;
+		}
+
+		/// Removes all entries and resets the monotone bound to 0; keeps bucket storage.
+		void clear() noexcept {
+			for (auto& b : buckets_) b.clear();
+			nonempty_ = 0;
+			last_ = 0;
+			n_ = 0;
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return n_ == 0; }
+		[[nodiscard]] std::size_t size() const noexcept { return n_; }
+
+		/// @return Lower bound for future keys (the last extracted minimum, or 0).
+		[[nodiscard]] Key last_key() const noexcept { return last_; }
+	};
+
+} // namespace kj::detail
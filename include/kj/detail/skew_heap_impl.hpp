@@ -3,28 +3,119 @@
 #include <cstddef>
 #include <functional>
 #include <type_traits>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <concepts>
+#include <span>
+#include <new>
+#include <algorithm>
+#include <kj/buffer.hpp>
+#include <kj/scope_guard.hpp>
 #include <kj/detail/object_pool.hpp>
 
 namespace kj::detail {
 
+	/// Default push-down hook for @ref skew_merge: nodes carry no pending updates.
+	struct skew_no_push {
+		template <class Node>
+		void operator()(Node*) const noexcept {}
+	};
+
+	/// Default link hook for @ref skew_merge: nodes carry no parent pointers.
+	struct skew_no_link {
+		template <class Node>
+		void operator()(Node*, Node*) const noexcept {}
+	};
+
+	/**
+	 * @brief Top-down iterative skew heap merge (no recursion, O(1) stack).
+	 *
+	 * Walks the two right spines in key order; every node on the merge path gets its
+	 * children swapped, exactly as in the classic recursive formulation, so the resulting
+	 * tree and the O(log n) amortized bound are the same.
+	 *
+	 * @p push is called on each path node before its children are inspected, so trees
+	 * with lazily propagated tags can settle their children's keys first. @p link is
+	 * called as @c link(parent, child) whenever a node gets a new left child, so trees
+	 * with parent pointers can keep them current.
+	 *
+	 * @tparam Node Node type with @c key, @c left and @c right members.
+	 */
+	template <class Node, class Comp, class Push = skew_no_push, class Link = skew_no_link>
+	Node* skew_merge(Node* a, Node* b, Comp& cmp, Push push = {}, Link link = {}) noexcept(
+		noexcept(cmp(std::declval<const decltype(a->key)&>(), std::declval<const decltype(a->key)&>())) &&
+		noexcept(push(a)) && noexcept(link(a, a))
+		) {
+		if (!a) return b;
+		if (!b) return a;
+		if (cmp(b->key, a->key)) std::swap(a, b);     // ensure 'a' has preferred root
+		Node* const root = a;
+		for (;;) {
+			// a->left := merge(a->right, b), a->right := old a->left (skew step)
+			push(a);
+			Node* r = a->right;
+			a->right = a->left;
+			if (!r) { a->left = b; link(a, b); break; }
+			if (cmp(b->key, r->key)) std::swap(r, b);
+			a->left = r;
+			link(a, r);
+			a = r;
+		}
+		return root;
+	}
+
+	/**
+	 * @brief Classic recursive skew heap merge (reference for @ref skew_merge).
+	 *
+	 * Uses stack proportional to the length of the merged right spines.
+	 */
+	template <class Node, class Comp>
+	Node* skew_merge_recursive(Node* a, Node* b, Comp& cmp) noexcept(
+		noexcept(cmp(std::declval<const decltype(a->key)&>(), std::declval<const decltype(a->key)&>()))
+		) {
+		if (!a) return b;
+		if (!b) return a;
+		if (cmp(b->key, a->key)) std::swap(a, b);
+		a->right = skew_merge_recursive(a->right, b, cmp);
+		std::swap(a->left, a->right);
+		return a;
+	}
+
 	/**
 	 * @brief Skew heap (mergeable heap) with optional internal node pool.
 	 *
 	 * By default this is a min-heap via @p std::less<T>. Use @p std::greater<T> for a max-heap.
-	 * If @p UsePool is true, node allocations are served from an internal @ref ObjectPool,
-	 * which can dramatically reduce allocation overhead for heavy workloads.
+	 * If @p UsePool is true, node allocations are served from an @ref ObjectPool,
+	 * which can dramatically reduce allocation overhead for heavy workloads. The pool is
+	 * either owned by the heap (created on first use) or shared by reference between many
+	 * heaps (see @ref pool_type); heaps on the same pool can be merged without copying.
+	 *
+	 * If @p Lazy is true, every node carries an additive tag pending for its subtree, so
+	 * @ref add_all adds a constant to every key in O(1); tags are pushed down along the
+	 * merge path and on pop. @p T must then be value-initializable to zero and support
+	 * @c +=, and the comparator must be invariant under adding a constant.
 	 *
 	 * @tparam T       Key type.
 	 * @tparam Comp    Comparator (StrictWeakOrder), defaults to @c std::less<T>.
 	 * @tparam UsePool If true, use @ref ObjectPool for node storage (default: false).
+	 * @tparam Lazy    If true, support @ref add_all via per-node additive tags (default: false).
 	 */
-	template <class T, class Comp = std::less<T>, bool UsePool = false>
+	template <class T, class Comp = std::less<T>, bool UsePool = false, bool Lazy = false>
 	class SkewHeap {
 	private:
 		/**
 		 * @brief Internal node type.
 		 */
-		struct Node {
+		// Pending addition for both children's subtrees (key already includes it). Kept in
+		// a base so the non-lazy node stays {key, left, right} on every compiler (empty base
+		// optimization, unlike [[no_unique_address]], is also honoured by MSVC).
+		template <bool HasTag, class = void>
+		struct NodeTag {};
+		template <class Dummy>
+		struct NodeTag<true, Dummy> { T tag{}; };
+
+		struct Node : NodeTag<Lazy> {
 			T     key;
 			Node* left;
 			Node* right;
@@ -33,22 +124,39 @@ namespace kj::detail {
 			explicit Node(U&& v) : key(std::forward<U>(v)), left(nullptr), right(nullptr) {}
 		};
 
+		struct PlainNode { T key; Node* left; Node* right; };
+		static_assert(Lazy || sizeof(Node) == sizeof(PlainNode), "SkewHeap: non-lazy nodes must not carry tag storage");
+
 		using PoolT = std::conditional_t<UsePool, ObjectPool<Node>, struct __kj_no_pool_tag>;
 
+		/// Pool binding: @c ptr is the pool in use, @c own holds it if this heap created it.
+		struct PoolRef {
+			PoolT* ptr = nullptr;
+			std::unique_ptr<PoolT> own;
+		};
+
 		Node* root_ = nullptr;
 		std::size_t  sz_ = 0;
 #if defined(__has_cpp_attribute) && __has_cpp_attribute(no_unique_address)
 		[[no_unique_address]]
 #endif
 		Comp         cmp_{};
-		// Pool present only if UsePool == true (otherwise no storage cost)
-		[[no_unique_address]] std::conditional_t<UsePool, PoolT, char> pool_{};
+		// Pool binding present only if UsePool == true (otherwise no storage cost)
+		[[no_unique_address]] std::conditional_t<UsePool, PoolRef, char> pool_{};
 
 		// ---- allocation helpers -------------------------------------------------
+		PoolT& pool_ref() {
+			if (!pool_.ptr) {
+				pool_.own = std::make_unique<PoolT>();
+				pool_.ptr = pool_.own.get();
+			}
+			return *pool_.ptr;
+		}
+
 		template <class U>
 		Node* make_node(U&& v) {
 			if constexpr (UsePool) {
-				return pool_.create(std::forward<U>(v));
+				return pool_ref().create(std::forward<U>(v));
 			}
 			else {
 				return new Node(std::forward<U>(v));
@@ -63,57 +171,197 @@ namespace kj::detail {
 			}
 		}
 
+		// ---- lazy tags ------------------------------------------------------------
+		static void add_to(Node* n, const T& d) {
+			n->key += d;
+			n->tag += d;
+		}
+
+		// Hands the pending tag of @p n down to its children.
+		static void push_down(Node* n) {
+			if constexpr (Lazy) {
+				if constexpr (std::equality_comparable<T>) {
+					if (n->tag == T{}) return;
+				}
+				if (n->left) add_to(n->left, n->tag);
+				if (n->right) add_to(n->right, n->tag);
+				n->tag = T{};
+			}
+		}
+
 		// ---- core merge on nodes ------------------------------------------------
 		static Node* merge_nodes(Node* a, Node* b, Comp& cmp) noexcept(
-			noexcept(cmp(std::declval<const T&>(), std::declval<const T&>()))
+			noexcept(cmp(std::declval<const T&>(), std::declval<const T&>())) && !Lazy
 			) {
-			if (!a) return b;
-			if (!b) return a;
-			if (cmp(b->key, a->key)) std::swap(a, b);     // ensure 'a' has preferred root
-			a->right = merge_nodes(a->right, b, cmp);     // merge b into a->right
-			std::swap(a->left, a->right);                 // skew step
-			return a;
+			// iterative, no stack growth
+			if constexpr (Lazy) return skew_merge(a, b, cmp, [](Node* n) { push_down(n); });
+			else return skew_merge(a, b, cmp);
+		}
+
+		// Iterative teardown: rotating left children up turns the tree into
+		// a right-linked list on the fly, so no stack is used (O(n) time, O(1) space).
+		template <class Free>
+		static void destroy_iter(Node* n, Free&& free_node) noexcept {
+			while (n) {
+				if (Node* l = n->left) {
+					n->left = l->right;
+					l->right = n;
+					n = l;
+				}
+				else {
+					Node* next = n->right;
+					free_node(n);
+					n = next;
+				}
+			}
+		}
+		// Bottom-up build: merge neighbours pairwise, round after round (a FIFO queue of
+		// heaps processed in place). Each round halves the count, O(n) total.
+		static Node* build_nodes(std::vector<Node*>& q, Comp& cmp) {
+			std::size_t m = q.size();
+			while (m > 1) {
+				std::size_t j = 0;
+				for (std::size_t i = 0; i + 1 < m; i += 2) q[j++] = merge_nodes(q[i], q[i + 1], cmp);
+				if (m & 1) q[j++] = q[m - 1];
+				m = j;
+			}
+			return m ? q[0] : nullptr;
+		}
+
+		// Moves the k best keys to dst[0..k) in order; @p Construct selects placement-new
+		// (raw storage) over assignment. Taking the whole heap skips the n merges: the tree is
+		// walked once without auxiliary storage (the rotation walk of destroy_iter) and the
+		// keys are sorted in place; when this heap owns every live node of its pool (trivial
+		// T) the nodes are recycled by one pool reset. A partial extraction chains the popped
+		// nodes through @c left and hands them back to the pool in one batch.
+		template <bool Construct>
+		std::size_t extract_(std::size_t k, T* dst) {
+			auto put = [dst](std::size_t i, T&& v) {
+				if constexpr (Construct) ::new (static_cast<void*>(dst + i)) T(std::move(v));
+				else dst[i] = std::move(v);
+			};
+			std::size_t i = 0;
+			if (k >= sz_) {
+				bool bulk = false;
+				if constexpr (UsePool && std::is_trivially_destructible_v<T>) {
+					bulk = pool_.ptr && pool_.ptr->live() == sz_;
+				}
+				// Detach first, so a throwing put() or sort leaves an empty heap; the guard
+				// frees what the walk has not reached, or recycles the pool in bulk mode.
+				Node* n = root_;
+				root_ = nullptr;
+				sz_ = 0;
+				auto unwind = scope_exit([&] {
+					if constexpr (UsePool && std::is_trivially_destructible_v<T>) {
+						if (bulk) { pool_.ptr->reset(); return; }
+					}
+					if constexpr (UsePool) destroy_subtree_pool(*pool_.ptr, n);
+					else destroy_subtree(n);
+				});
+				while (n) {
+					push_down(n);
+					if (Node* l = n->left) {
+						push_down(l);          // l's tag must not reach n after the rotation
+						n->left = l->right;
+						l->right = n;
+						n = l;
+						continue;
+					}
+					Node* next = n->right;
+					put(i++, std::move(n->key));
+					if (!bulk) {
+						if constexpr (UsePool) pool_.ptr->destroy(n);
+						else delete n;
+					}
+					n = next;
+				}
+				std::sort(dst, dst + i, cmp_);
+				return i;
+			}
+			Node* done = nullptr;
+			auto free_done = [&](bool batch) {
+				if constexpr (UsePool) {
+					if (batch) { pool_.ptr->destroy_list(done, i, [](Node* x) { return x->left; }); return; }
+				}
+				while (done) {
+					Node* next = done->left;
+					if constexpr (UsePool) pool_.ptr->destroy(done);
+					else delete done;
+					done = next;
+				}
+			};
+			auto unwind = scope_exit([&] { free_done(false); sz_ -= i; });
+			for (; i < k; ++i) {
+				Node* n = root_;
+				push_down(n);
+				put(i, std::move(n->key));
+				root_ = merge_nodes(n->left, n->right, cmp_);
+				n->left = done;
+				done = n;
+			}
+			unwind.dismiss();
+			free_done(true);
+			sz_ -= k;
+			return k;
 		}
 
 		static void destroy_subtree(Node* n) noexcept {
-			if (!n) return;
-			destroy_subtree(n->left);
-			destroy_subtree(n->right);
-			delete n;
+			destroy_iter(n, [](Node* x) noexcept { delete x; });
 		}
 		static void destroy_subtree_pool(PoolT& pool, Node* n) noexcept {
-			if (!n) return;
-			destroy_subtree_pool(pool, n->left);
-			destroy_subtree_pool(pool, n->right);
-			pool.destroy(n);
+			destroy_iter(n, [&pool](Node* x) noexcept { pool.destroy(x); });
 		}
 
 	public:
+		/**
+		 * @brief Node pool type usable for sharing one pool between heaps (UsePool only).
+		 *
+		 * The shared pool must outlive every heap bound to it.
+		 */
+		using pool_type = PoolT;
+
 		//-------------------------------------------------------------------------
 		// Construction / destruction
 		//-------------------------------------------------------------------------
 
-		/// Constructs an empty heap. If @p UsePool is true, an internal pool is created.
+		/// Constructs an empty heap. If @p UsePool is true, an own pool is created on first use.
 		SkewHeap() = default;
 
 		/// Constructs an empty heap with a custom comparator.
 		explicit SkewHeap(const Comp& c) : cmp_(c) {}
 
-		/// Releases all nodes (O(n)). If @p UsePool, nodes return to the pool.
+		/**
+		 * @brief Builds a heap from [@p first, @p last) in O(n) (see @ref push_range).
+		 */
+		template <class It, class = std::enable_if_t<
+			std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>>>
+		SkewHeap(It first, It last, const Comp& c = Comp{}) : cmp_(c) {
+			push_range(first, last);
+		}
+
+		/**
+		 * @brief Constructs an empty heap allocating from the shared @p pool (UsePool only).
+		 */
+		template <bool P = UsePool, std::enable_if_t<P, int> = 0>
+		explicit SkewHeap(pool_type& pool, const Comp& c = Comp{}) : cmp_(c) {
+			pool_.ptr = &pool;
+		}
+
+		/// Releases all nodes (see @ref clear). If @p UsePool, nodes return to the pool.
 		~SkewHeap() { clear(); }
 
 		SkewHeap(const SkewHeap&) = delete;
 		SkewHeap& operator=(const SkewHeap&) = delete;
 
+		// Moving transfers the tree together with the pool binding (an owned pool lives on
+		// the heap, so node addresses stay valid). Move construction leaves the source empty
+		// and unbound; move assignment hands the target's previous pool binding to the
+		// source, so an owned pool other heaps may still be bound to (see @ref pool) is
+		// never destroyed by the assignment.
 		SkewHeap(SkewHeap&& other) noexcept
-			: root_(other.root_), sz_(other.sz_), cmp_(std::move(other.cmp_))
+			: root_(other.root_), sz_(other.sz_), cmp_(std::move(other.cmp_)), pool_(std::move(other.pool_))
 		{
-			if constexpr (UsePool) {
-				// Pools cannot be moved trivially here; keep separate pools per instance.
-				// Steal only the tree; resulting nodes remain owned by this instance's pool.
-				// For safety, forbid moving when UsePool is true (or implement pool move).
-				static_assert(!UsePool, "Move-constructing SkewHeap with UsePool is intentionally disabled.");
-			}
+			if constexpr (UsePool) other.pool_.ptr = nullptr;
 			other.root_ = nullptr; other.sz_ = 0;
 		}
 		SkewHeap& operator=(SkewHeap&& other) noexcept {
@@ -122,28 +370,42 @@ namespace kj::detail {
 				root_ = other.root_; sz_ = other.sz_;
 				cmp_ = std::move(other.cmp_);
 				if constexpr (UsePool) {
-					static_assert(!UsePool, "Move-assigning SkewHeap with UsePool is intentionally disabled.");
+					using std::swap;
+					swap(pool_, other.pool_);
 				}
 				other.root_ = nullptr; other.sz_ = 0;
 			}
 			return *this;
 		}
 
+		/**
+		 * @brief Exchanges contents (and pool bindings) with @p other in O(1).
+		 */
+		void swap(SkewHeap& other) noexcept {
+			using std::swap;
+			swap(root_, other.root_);
+			swap(sz_, other.sz_);
+			swap(cmp_, other.cmp_);
+			swap(pool_, other.pool_);
+		}
+
+		friend void swap(SkewHeap& a, SkewHeap& b) noexcept { a.swap(b); }
+
 		//-------------------------------------------------------------------------
 		// Pool controls (no-op when UsePool == false)
 		//-------------------------------------------------------------------------
 
 		/**
-		 * @brief Pre-allocates approximately @p n node slots in the internal pool.
+		 * @brief Pre-allocates approximately @p n node slots in the pool in use.
 		 * No-op if @p UsePool is false.
 		 */
 		void reserve_nodes(std::size_t n) {
-			if constexpr (UsePool) pool_.reserve(n);
+			if constexpr (UsePool) pool_ref().reserve(n);
 		}
 
 		/**
-		 * @brief Releases all pool blocks. The heap must be empty.
-		 * No-op if @p UsePool is false.
+		 * @brief Releases all blocks of the own pool. The heap must be empty.
+		 * No-op if @p UsePool is false or the heap uses a shared pool.
 		 */
 		void release_all_to_pool() noexcept {
 			if constexpr (UsePool) {
@@ -151,17 +413,42 @@ namespace kj::detail {
 				// defensive: ensure heap is empty before releasing pool memory
 				assert(root_ == nullptr && "release_all_to_pool() requires empty heap");
 #endif
-				pool_.release_all();
+				if (pool_.own) pool_.own->release_all();
 			}
 		}
 
+		/**
+		 * @brief Returns the pool in use, e.g. to bind more heaps to it (UsePool only).
+		 *
+		 * Heaps bound to another heap's own pool must be destroyed before that heap (or,
+		 * after a move assignment into it, before the moved-from source that now owns it).
+		 */
+		template <bool P = UsePool, std::enable_if_t<P, int> = 0>
+		pool_type& pool() { return pool_ref(); }
+
 		//-------------------------------------------------------------------------
 		// Observers
 		//-------------------------------------------------------------------------
 
+		/**
+		 * @brief Removes all elements.
+		 *
+		 * O(n) and stack-free in general. For @p UsePool with trivially destructible @p T,
+		 * when every live node of the pool belongs to this heap, the whole pool is recycled
+		 * in O(1) without visiting the nodes.
+		 */
 		void clear() noexcept {
 			if constexpr (UsePool) {
-				destroy_subtree_pool(pool_, root_);
+				if (pool_.ptr) {
+					PoolT& pool = *pool_.ptr;
+					if constexpr (std::is_trivially_destructible_v<T>) {
+						if (pool.live() == sz_) pool.reset();
+						else destroy_subtree_pool(pool, root_);
+					}
+					else {
+						destroy_subtree_pool(pool, root_);
+					}
+				}
 			}
 			else {
 				destroy_subtree(root_);
@@ -192,19 +479,107 @@ namespace kj::detail {
 			++sz_;
 		}
 
+		/**
+		 * @brief Inserts all elements of [@p first, @p last) in O(k + log n).
+		 *
+		 * The new elements are built into one heap bottom-up with pairwise merges and then
+		 * melded with the existing tree. With @p UsePool all k nodes are taken from the pool
+		 * as one contiguous run.
+		 */
+		template <class It>
+		void push_range(It first, It last) {
+			const auto k = static_cast<std::size_t>(std::distance(first, last));
+			if (k == 0) return;
+			std::vector<Node*> q(k);
+			// All nodes are built before the heap is touched; if a copy throws, the ones
+			// made so far (and, with a pool, the rest of the run) are given back.
+			std::size_t made = 0;
+			if constexpr (UsePool) {
+				PoolT& pool = pool_ref();
+				Node* run = pool.allocate_run(k);
+				auto unwind = scope_exit([&] {
+					for (std::size_t i = 0; i < made; ++i) pool.destroy(run + i);
+					for (std::size_t i = made; i < k; ++i) pool.deallocate(run + i);
+				});
+				for (; made < k; ++made, ++first) q[made] = ::new (static_cast<void*>(run + made)) Node(*first);
+				unwind.dismiss();
+			}
+			else {
+				auto unwind = scope_exit([&] { for (std::size_t i = 0; i < made; ++i) delete q[i]; });
+				for (; made < k; ++made, ++first) q[made] = new Node(*first);
+				unwind.dismiss();
+			}
+			root_ = merge_nodes(root_, build_nodes(q, cmp_), cmp_);
+			sz_ += k;
+		}
+
 		void pop() {
+			push_down(root_);
 			Node* l = root_->left;
 			Node* r = root_->right;
-			if constexpr (UsePool) pool_.destroy(root_);
+			if constexpr (UsePool) pool_.ptr->destroy(root_);
 			else delete root_;
 			root_ = merge_nodes(l, r, cmp_);
 			--sz_;
 		}
 
+		/**
+		 * @brief Moves the min(@p k, size(), out.size()) best keys into @p out in order.
+		 *
+		 * Same result as repeated top()/pop() (up to the order of equivalent keys), but keys
+		 * are moved rather than copied. Taking every element costs one tree walk plus a sort
+		 * instead of n merges; draining a pool the heap owns alone (trivial @p T) recycles all
+		 * nodes with one pool reset.
+		 *
+		 * @return Number of elements written.
+		 */
+		std::size_t pop_k(std::size_t k, std::span<T> out) {
+			return extract_<false>(std::min({ k, sz_, out.size() }), out.data());
+		}
+
+		/**
+		 * @brief Empties the heap into @p out in sorted order (see @ref pop_k).
+		 *
+		 * @p out is reallocated if it is smaller than size(). kj::Buffer does not run element
+		 * destructors, so @p T must be trivially destructible.
+		 *
+		 * @return Number of elements written (the former size()).
+		 */
+		std::size_t drain_sorted(Buffer<T>& out) {
+			static_assert(std::is_trivially_destructible_v<T>,
+				"SkewHeap::drain_sorted(kj::Buffer&) requires a trivially destructible T; use pop_k");
+			if (out.size() < sz_) out = Buffer<T>(sz_);
+			return extract_<true>(sz_, out.data());
+		}
+
+		/**
+		 * @brief Adds @p delta to every key in O(1) (Lazy only).
+		 *
+		 * The root absorbs @p delta and records it as a tag for its subtrees; the tag
+		 * travels down only when merge or pop visits the node.
+		 */
+		template <bool L = Lazy, std::enable_if_t<L, int> = 0>
+		void add_all(const T& delta) {
+			if (root_) add_to(root_, delta);
+		}
+
+		/**
+		 * @brief Moves all elements of @p other into this heap; @p other becomes empty.
+		 *
+		 * O(log n) amortized by linking the trees. For @p UsePool the two heaps must share a
+		 * pool for that; otherwise the elements are moved over one by one into this heap's pool.
+		 */
 		void merge(SkewHeap& other) {
 			if (this == &other) return;
-			// NOTE: When UsePool==true, each heap owns its own pool. Merging trees across pools
-			// is fine because nodes are just pointers; lifetime is bound to the destination heap.
+			if constexpr (UsePool) {
+				if (other.root_ && &pool_ref() != other.pool_.ptr) {
+					while (!other.empty()) {
+						push(std::move(other.root_->key));
+						other.pop();
+					}
+					return;
+				}
+			}
 			root_ = merge_nodes(root_, other.root_, cmp_);
 			sz_ += other.sz_;
 			other.root_ = nullptr;
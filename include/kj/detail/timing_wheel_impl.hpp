@@ -0,0 +1,312 @@
+#pragma once
+#include <bit>
+#include <array>
+#include <chrono>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <kj/timer.hpp>
+#include <kj/detail/buffer_vector.hpp>
+
+namespace kj::detail {
+
+	/**
+	 * @brief Handle of a scheduled timer (index + generation, safe to use after expiry).
+	 */
+	struct TimerHandle {
+		std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t generation = 0;
+	};
+
+	/**
+	 * @brief Hierarchical timing wheel with O(1) schedule and cancel.
+	 *
+	 * Time is counted in ticks of a fixed duration since construction, measured on
+	 * kj::Timer's clock. The wheel has 11 levels of 64 slots (covering all 64-bit tick
+	 * values, so no overflow list): a timer expiring at tick @c e sits on the level of the
+	 * highest base-64 digit in which @c e differs from the current tick, in the slot of
+	 * that digit. Every level keeps a 64-bit occupancy mask, so the next tick with work is
+	 * found in O(levels) word operations and idle stretches are skipped. When the current
+	 * tick enters a slot of an upper level, that slot is cascaded to lower levels; a timer
+	 * moves down at most once per level.
+	 *
+	 * Timer entries live in a slab with a free list (no allocation per timer once warm)
+	 * and are linked into slots by index. Handles carry a generation, so cancelling an
+	 * already expired or cancelled timer is detected and ignored.
+	 *
+	 * Expired payloads are delivered in batches: @ref advance appends all of them, ordered
+	 * by expiry tick (unspecified within a tick), to an output vector.
+	 *
+	 * @tparam Payload Value delivered on expiry (default-constructible, movable).
+	 */
+	template <class Payload>
+	class TimingWheel {
+	public:
+		using clock = Timer::clock;
+		using duration = clock::duration;
+		using time_point = clock::time_point;
+		using handle = TimerHandle;
+		static_assert(clock::is_steady, "TimingWheel: deadlines must not follow wall-clock jumps");
+
+	private:
+		static constexpr unsigned bits_ = 6;
+		static constexpr unsigned slots_ = 1u << bits_;
+		static constexpr unsigned levels_ = (64 + bits_ - 1) / bits_;
+		static constexpr std::uint32_t nil_ = std::numeric_limits<std::uint32_t>::max();
+
+		struct Entry {
+			std::uint64_t expires = 0;
+			std::uint32_t prev = nil_;
+			std::uint32_t next = nil_;      // also the free-list link
+			std::uint32_t generation = 0;
+			std::uint16_t slot = 0;         // level * 64 + slot index
+			bool live = false;
+			Payload payload{};
+		};
+
+		struct Slot {
+			std::uint32_t head = nil_;
+			std::uint32_t tail = nil_;
+		};
+
+		BufferVector<Entry> entries_;
+		std::uint32_t free_ = nil_;
+		std::array<Slot, levels_ * slots_> slot_{};
+		std::array<std::uint64_t, levels_> mask_{};
+		std::uint64_t now_ = 0;
+		std::size_t live_ = 0;
+		duration tick_;
+		time_point origin_;
+
+		// ---- slab ------------------------------------------------------------------
+		std::uint32_t alloc_() {
+			if (free_ != nil_) {
+				const std::uint32_t i = free_;
+				free_ = entries_[i].next;
+				return i;
+			}
+			assert(entries_.size() < nil_ && "TimingWheel: too many timers");
+			entries_.emplace_back();
+			return static_cast<std::uint32_t>(entries_.size() - 1);
+		}
+		void free_entry(std::uint32_t i) noexcept {
+			Entry& e = entries_[i];
+			e.live = false;
+			++e.generation;
+			e.next = free_;
+			free_ = i;
+		}
+
+		// ---- slot lists --------------------------------------------------------------
+		void link(std::uint32_t i) noexcept {
+			Entry& e = entries_[i];
+			const std::uint64_t x = e.expires ^ now_;
+			const unsigned level = x ? (static_cast<unsigned>(std::bit_width(x)) - 1) / bits_ : 0;
+			const unsigned s = static_cast<unsigned>(e.expires >> (level * bits_)) & (slots_ - 1);
+			e.slot = static_cast<std::uint16_t>(level * slots_ + s);
+			Slot& sl = slot_[e.slot];
+			e.prev = sl.tail;
+			e.next = nil_;
+			if (sl.tail != nil_) entries_[sl.tail].next = i;
+			else sl.head = i;
+			sl.tail = i;
+			mask_[level] |= std::uint64_t{ 1 } << s;
+		}
+		void unlink(std::uint32_t i) noexcept {
+			Entry& e = entries_[i];
+			Slot& sl = slot_[e.slot];
+			if (e.prev != nil_) entries_[e.prev].next = e.next;
+			else sl.head = e.next;
+			if (e.next != nil_) entries_[e.next].prev = e.prev;
+			else sl.tail = e.prev;
+			if (sl.head == nil_) mask_[e.slot / slots_] &= ~(std::uint64_t{ 1 } << (e.slot % slots_));
+		}
+
+		// Next tick >= now_ at which a slot must be fired (level 0) or cascaded.
+		bool next_event(std::uint64_t& tick, unsigned& level, unsigned& s) const noexcept {
+			for (unsigned l = 0; l < levels_; ++l) {
+				if (!mask_[l]) continue;
+				const unsigned shift = l * bits_;
+				const unsigned digit = static_cast<unsigned>(now_ >> shift) & (slots_ - 1);
+				// level 0 may fire the current tick; upper levels only hold later digits
+				const std::uint64_t m = mask_[l] & (~std::uint64_t{ 0 } << digit);
+				if (!m) continue;
+				s = static_cast<unsigned>(std::countr_zero(m));
+				level = l;
+				const std::uint64_t above = (shift + bits_ >= 64) ? 0 : (now_ >> (shift + bits_)) << (shift + bits_);
+				tick = above | (std::uint64_t{ s } << shift);
+				if (tick < now_) tick = now_;   // only for level 0, digit == current
+				return true;
+			}
+			return false;
+		}
+
+		void schedule_tick_(std::uint32_t i) noexcept { link(i); ++live_; }
+
+	public:
+		/**
+		 * @brief Creates a wheel with the given tick length, starting at @p origin.
+		 */
+		explicit TimingWheel(duration tick = std::chrono::milliseconds(1), time_point origin = clock::now())
+			: tick_(tick), origin_(origin) {
+			assert(tick.count() > 0 && "TimingWheel: tick must be positive");
+		}
+
+		TimingWheel(const TimingWheel&) = delete;
+		TimingWheel& operator=(const TimingWheel&) = delete;
+
+		/// Pre-allocates storage for @p n timers.
+		void reserve(std::size_t n) { entries_.reserve(n); }
+
+		//-------------------------------------------------------------------------
+		// Scheduling
+		//-------------------------------------------------------------------------
+
+		/**
+		 * @brief Schedules @p p to expire @p ticks ticks after the wheel's current tick (O(1)).
+		 *
+		 * 0 means "on the next advance".
+		 */
+		handle schedule_in_ticks(std::uint64_t ticks, Payload p) {
+			const std::uint32_t i = alloc_();
+			Entry& e = entries_[i];
+			e.expires = ticks > std::numeric_limits<std::uint64_t>::max() - now_ ? std::numeric_limits<std::uint64_t>::max() : now_ + ticks;
+			e.live = true;
+			e.payload = std::move(p);
+			schedule_tick_(i);
+			return handle{ i, e.generation };
+		}
+
+		/**
+		 * @brief Schedules @p p for @p delay after the wheel's current time, rounded up to ticks.
+		 */
+		handle schedule_after(duration delay, Payload p) {
+			const auto t = delay.count() <= 0 ? 0 : (delay.count() + tick_.count() - 1) / tick_.count();
+			return schedule_in_ticks(static_cast<std::uint64_t>(t), std::move(p));
+		}
+
+		/**
+		 * @brief Schedules @p p at absolute time @p when (rounded up to ticks; past = next advance).
+		 */
+		handle schedule_at(time_point when, Payload p) {
+			const auto d = (when - origin_).count();
+			const std::uint64_t e = d <= 0 ? 0 : static_cast<std::uint64_t>((d + tick_.count() - 1) / tick_.count());
+			return schedule_in_ticks(e > now_ ? e - now_ : 0, std::move(p));
+		}
+
+		/**
+		 * @brief Cancels a pending timer in O(1).
+		 * @return false if @p h already expired, was cancelled, or is invalid.
+		 */
+		bool cancel(handle h) noexcept {
+			if (!pending(h)) return false;
+			unlink(h.index);
+			entries_[h.index].payload = Payload{};
+			free_entry(h.index);
+			--live_;
+			return true;
+		}
+
+		/// @return Whether @p h refers to a timer that has neither expired nor been cancelled.
+		[[nodiscard]] bool pending(handle h) const noexcept {
+			return h.index < entries_.size() && entries_[h.index].generation == h.generation && entries_[h.index].live;
+		}
+
+		//-------------------------------------------------------------------------
+		// Advancing
+		//-------------------------------------------------------------------------
+
+		/**
+		 * @brief Moves the wheel forward by @p ticks and appends expired payloads to @p expired.
+		 * @return Number of timers that expired.
+		 */
+		std::size_t advance_ticks(std::uint64_t ticks, std::vector<Payload>& expired) {
+			const std::uint64_t target = ticks > std::numeric_limits<std::uint64_t>::max() - now_
+				? std::numeric_limits<std::uint64_t>::max() : now_ + ticks;
+			return advance_to_tick(target, expired);
+		}
+
+		/**
+		 * @brief Processes every tick up to and including @p target (skipping empty stretches).
+		 *
+		 * If appending to @p expired throws, the timers not yet handed over stay pending and
+		 * fire on the next advance.
+		 *
+		 * @return Number of timers that expired.
+		 */
+		std::size_t advance_to_tick(std::uint64_t target, std::vector<Payload>& expired) {
+			std::size_t fired = 0;
+			std::uint64_t tick;
+			unsigned level, s;
+			while (next_event(tick, level, s) && tick <= target) {
+				now_ = tick;
+				Slot& sl = slot_[level * slots_ + s];
+				if (level == 0) {
+					// An entry leaves the slot only after its payload was handed over, so if
+					// push_back throws the rest stays pending and the counters stay exact.
+					while (sl.head != nil_) {
+						const std::uint32_t i = sl.head;
+						expired.push_back(std::move(entries_[i].payload));
+						sl.head = entries_[i].next;
+						if (sl.head != nil_) entries_[sl.head].prev = nil_;
+						else sl.tail = nil_;
+						free_entry(i);
+						--live_;
+						++fired;
+					}
+					mask_[0] &= ~(std::uint64_t{ 1 } << s);
+				}
+				else {
+					// cascade: every entry now lands on a lower level (link does not throw)
+					std::uint32_t i = sl.head;
+					sl.head = sl.tail = nil_;
+					mask_[level] &= ~(std::uint64_t{ 1 } << s);
+					while (i != nil_) {
+						const std::uint32_t next = entries_[i].next;
+						link(i);
+						i = next;
+					}
+				}
+			}
+			if (target > now_) now_ = target;
+			return fired;
+		}
+
+		/**
+		 * @brief Advances to the tick containing @p now (default: the clock's current time).
+		 * @return Number of timers that expired.
+		 */
+		std::size_t advance(std::vector<Payload>& expired, time_point now = clock::now()) {
+			const auto d = (now - origin_).count();
+			return advance_to_tick(d <= 0 ? 0 : static_cast<std::uint64_t>(d / tick_.count()), expired);
+		}
+
+		//-------------------------------------------------------------------------
+		// Observers
+		//-------------------------------------------------------------------------
+
+		[[nodiscard]] std::size_t size() const noexcept { return live_; }
+		[[nodiscard]] bool empty() const noexcept { return live_ == 0; }
+
+		/// @return Current tick (ticks since the origin processed so far).
+		[[nodiscard]] std::uint64_t now_tick() const noexcept { return now_; }
+
+		/// @return Tick length.
+		[[nodiscard]] duration tick() const noexcept { return tick_; }
+
+		/**
+		 * @brief Lower bound for the next expiry tick (exact if it is on level 0), or max if empty.
+		 *
+		 * Useful to decide how long an event loop may sleep.
+		 */
+		[[nodiscard]] std::uint64_t next_event_tick() const noexcept {
+			std::uint64_t t;
+			unsigned l, s;
+			return next_event(t, l, s) ? t : std::numeric_limits<std::uint64_t>::max();
+		}
+	};
+
+} // namespace kj::detail
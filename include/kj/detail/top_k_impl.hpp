@@ -0,0 +1,175 @@
+#pragma once
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <kj/detail/dary_heap_impl.hpp>
+#include <kj/detail/buffer_vector.hpp>
+
+namespace kj::detail {
+
+	/// Storage strategy of @ref TopK.
+	enum class TopKStrategy {
+		heap,     ///< k-element array heap with the worst kept element on top.
+		buffer,   ///< 2k buffer, compacted with nth_element when full (amortized O(1) per push).
+	};
+
+	/// Comparator with swapped arguments ("is worse than"), for generic comparators.
+	template <class Comp>
+	struct ReverseCompare {
+		[[no_unique_address]] Comp cmp;
+		template <class A, class B>
+		bool operator()(const A& a, const B& b) const { return cmp(b, a); }
+	};
+
+	/// Reversed comparator; keeps std::less/std::greater so the vectorized child scan applies.
+	template <class Comp> struct reverse_compare { using type = ReverseCompare<Comp>; };
+	template <class T> struct reverse_compare<std::less<T>> { using type = std::greater<T>; };
+	template <class T> struct reverse_compare<std::greater<T>> { using type = std::less<T>; };
+
+	/**
+	 * @brief Fixed-capacity selector of the k best elements of a stream.
+	 *
+	 * "Best" follows the heap convention of this library: with @p std::less<T> (default) the
+	 * k smallest elements are kept, with @p std::greater<T> the k largest. Once k elements
+	 * are held, a new element is rejected with a single comparison against the current
+	 * threshold. @ref push_batch filters blocks of arithmetic keys against the threshold
+	 * with branch-free compares (vectorizable) and skips blocks with no candidate.
+	 *
+	 * Elements that tie with the threshold are rejected.
+	 *
+	 * @tparam T        Element type.
+	 * @tparam Comp     Comparator (StrictWeakOrder), defaults to @c std::less<T>.
+	 * @tparam Strategy @ref TopKStrategy::heap (default) or @ref TopKStrategy::buffer.
+	 */
+	template <class T, class Comp = std::less<T>, TopKStrategy Strategy = TopKStrategy::heap>
+	class TopK {
+		using Worse = typename reverse_compare<Comp>::type;
+		using Heap = DaryHeap<T, Worse, 4>;
+		using Storage = std::conditional_t<Strategy == TopKStrategy::heap, Heap, BufferVector<T>>;
+
+		std::size_t k_;
+		Storage store_;
+		[[no_unique_address]] Comp cmp_{};
+		// buffer strategy: threshold from the last compaction (the k-th best so far)
+		[[no_unique_address]] std::conditional_t<Strategy == TopKStrategy::buffer, T, char> thr_{};
+		bool has_thr_ = false;
+
+		static constexpr std::size_t block_ = 16;
+
+		static Storage make_storage(const Comp& c) {
+			if constexpr (Strategy == TopKStrategy::buffer) return Storage{};
+			else if constexpr (std::is_same_v<Worse, ReverseCompare<Comp>>) return Heap(Worse{ c });
+			else return Heap{};
+		}
+
+		// Buffer strategy: keep the k best of the buffer and take the k-th as threshold.
+		void compact() {
+			auto kth = store_.begin() + static_cast<std::ptrdiff_t>(k_ - 1);
+			std::nth_element(store_.begin(), kth, store_.end(), cmp_);
+			thr_ = *kth;
+			has_thr_ = true;
+			while (store_.size() > k_) store_.pop_back();
+		}
+
+		[[nodiscard]] const T& threshold_ref() const noexcept {
+			if constexpr (Strategy == TopKStrategy::heap) return store_.top();
+			else return thr_;
+		}
+
+		[[nodiscard]] bool has_threshold() const noexcept {
+			if constexpr (Strategy == TopKStrategy::heap) return k_ && store_.size() == k_;
+			else return has_thr_;
+		}
+
+	public:
+		/**
+		 * @brief Creates a selector keeping at most @p k elements.
+		 */
+		explicit TopK(std::size_t k, const Comp& c = Comp{}) : k_(k), store_(make_storage(c)), cmp_(c) {
+			store_.reserve(Strategy == TopKStrategy::heap ? k : 2 * k);
+		}
+
+		/**
+		 * @brief Offers @p v to the selector.
+		 * @return false if @p v was rejected by the threshold (it may still be evicted later if accepted).
+		 */
+		bool push(const T& v) {
+			if (k_ == 0) return false;
+			if constexpr (Strategy == TopKStrategy::heap) {
+				if (store_.size() < k_) { store_.push(v); return true; }
+				if (!cmp_(v, store_.top())) return false;
+				store_.replace_top(v);
+				return true;
+			}
+			else {
+				if (has_thr_ && !cmp_(v, thr_)) return false;
+				store_.push_back(v);
+				if (store_.size() == 2 * k_) compact();
+				return true;
+			}
+		}
+
+		/**
+		 * @brief Offers all elements of @p batch.
+		 *
+		 * Once a threshold exists, blocks of 16 are first tested with branch-free compares
+		 * and skipped entirely when nothing in them beats the threshold.
+		 */
+		void push_batch(std::span<const T> batch) {
+			std::size_t i = 0;
+			const std::size_t n = batch.size();
+			while (i < n) {
+				if constexpr (dary_simd_compare_v<T, Comp>) {
+					if (has_threshold() && i + block_ <= n) {
+						const T t = threshold_ref();
+						const T* p = batch.data() + i;
+						bool any = false;
+						for (std::size_t j = 0; j < block_; ++j) any |= cmp_(p[j], t);
+						if (!any) { i += block_; continue; }
+						for (std::size_t j = 0; j < block_; ++j) push(p[j]);
+						i += block_;
+						continue;
+					}
+				}
+				push(batch[i++]);
+			}
+		}
+
+		/// Removes all elements (keeps storage).
+		void clear() noexcept {
+			store_.clear();
+			has_thr_ = false;
+		}
+
+		/// @return Number of elements currently held (at most 2k with the buffer strategy).
+		[[nodiscard]] std::size_t size() const noexcept {
+			return std::min(store_.size(), k_);
+		}
+		[[nodiscard]] bool empty() const noexcept { return store_.size() == 0; }
+		[[nodiscard]] std::size_t capacity() const noexcept { return k_; }
+
+		/**
+		 * @brief Returns the best min(k, pushed) elements in order and clears the selector.
+		 */
+		[[nodiscard]] std::vector<T> take_sorted() {
+			std::vector<T> out;
+			out.reserve(store_.size());
+			if constexpr (Strategy == TopKStrategy::heap) {
+				while (!store_.empty()) { out.push_back(store_.top()); store_.pop(); }   // worst first
+				std::reverse(out.begin(), out.end());
+			}
+			else {
+				for (auto& v : store_) out.push_back(std::move(v));
+				std::sort(out.begin(), out.end(), cmp_);
+				if (out.size() > k_) out.resize(k_);
+			}
+			clear();
+			return out;
+		}
+	};
+
+} // namespace kj::detail
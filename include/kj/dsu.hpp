@@ -10,6 +10,30 @@ namespace kj {
 	 */
 	using DSU = ::kj::detail::DSU;
 
+	/**
+	 * @brief Public alias for the DSU with operation counters and path-length histogram.
+	 *
+	 * Counters are read via @c dsu.stats.snapshot().
+	 *
+	 * @see kj::detail::BasicDSU, kj::detail::DSUStats
+	 */
+	using InstrumentedDSU = ::kj::detail::InstrumentedDSU;
+
+	/**
+	 * @brief Public alias for the counters reported by kj::InstrumentedDSU.
+	 *
+	 * @see kj::detail::DSUStatsSnapshot
+	 */
+	using DSUStatsSnapshot = ::kj::detail::DSUStatsSnapshot;
+
+	/**
+	 * @brief Public alias for the fixed-capacity, allocation-free constexpr DSU.
+	 *
+	 * @see kj::detail::FixedDSU
+	 */
+	template <std::size_t N>
+	using FixedDSU = ::kj::detail::FixedDSU<N>;
+
 	/**
 	 * @brief Public alias for the rollback-capable DSU (no path compression).
 	 *
@@ -17,4 +41,32 @@ namespace kj {
 	 */
 	using RollbackDSU = ::kj::detail::RollbackDSU;
 
+	/**
+	 * @brief Public alias for the RAII snapshot/rollback scope over kj::RollbackDSU.
+	 *
+	 * @see kj::detail::RollbackTransaction
+	 */
+	using RollbackTransaction = ::kj::detail::RollbackTransaction;
+
+	/**
+	 * @brief Public alias for the parity (bipartite) DSU with conflict detection.
+	 *
+	 * @see kj::detail::ParityDSU
+	 */
+	using ParityDSU = ::kj::detail::ParityDSU;
+
+	/**
+	 * @brief Public alias for the DSU answering "when did a and b become connected".
+	 *
+	 * @see kj::detail::TimedDSU
+	 */
+	using TimedDSU = ::kj::detail::TimedDSU;
+
+	/**
+	 * @brief Parallel tree-reduce merge of shard DSUs into the first one.
+	 *
+	 * @see kj::detail::merge_shards
+	 */
+	using ::kj::detail::merge_shards;
+
 } // namespace kj
@@ -0,0 +1,12 @@
+#pragma once
+#include <kj/detail/kway_merge_impl.hpp>
+
+namespace kj {
+
+	/// Balanced tournament meld of many heaps into the first one (see kj::detail::meld_all).
+	using ::kj::detail::meld_all;
+
+	/// Stable loser-tree k-way merge of sorted views (see kj::detail::merge_runs).
+	using ::kj::detail::merge_runs;
+
+} // namespace kj
@@ -0,0 +1,18 @@
+#pragma once
+#include <functional>
+#include <kj/detail/link_cut_tree_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the link-cut tree (dynamic forest connectivity).
+	 *
+	 * Use @c kj::LinkCutTree<> for connectivity only, or e.g.
+	 * @c kj::LinkCutTree<long long> for path sums.
+	 *
+	 * @see kj::detail::LinkCutTree
+	 */
+	template <class T = void, class Op = std::plus<>>
+	using LinkCutTree = ::kj::detail::LinkCutTree<T, Op>;
+
+} // namespace kj
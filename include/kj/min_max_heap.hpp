@@ -0,0 +1,15 @@
+#pragma once
+#include <functional>
+#include <kj/detail/min_max_heap_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the array-based min-max heap (double-ended priority queue).
+	 *
+	 * @see kj::detail::MinMaxHeap
+	 */
+	template<class T, class Comp = std::less<T>>
+	using MinMaxHeap = ::kj::detail::MinMaxHeap<T, Comp>;
+
+} // namespace kj
@@ -0,0 +1,19 @@
+#pragma once
+#include <functional>
+#include <kj/detail/multi_queue_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the relaxed concurrent priority queue (MultiQueue).
+	 *
+	 * @see kj::detail::MultiQueue
+	 */
+	template<class T, class Comp = std::less<T>, class Heap = ::kj::detail::DaryHeap<T, Comp, 8>>
+	using MultiQueue = ::kj::detail::MultiQueue<T, Comp, Heap>;
+
+	using MultiQueueStats = ::kj::detail::MultiQueueStats;
+	using RankErrorStats = ::kj::detail::RankErrorStats;
+	using ::kj::detail::rank_errors;
+
+} // namespace kj
@@ -0,0 +1,18 @@
+#pragma once
+#include <functional>
+#include <kj/detail/pairing_heap_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the pooled pairing heap (min-heap by default).
+	 *
+	 * Drop-in alternative to kj::SkewHeap / kj::AddressableSkewHeap for
+	 * decrease-key-heavy workloads.
+	 *
+	 * @see kj::detail::PairingHeap
+	 */
+	template<class T, class Comp = std::less<T>>
+	using PairingHeap = ::kj::detail::PairingHeap<T, Comp>;
+
+} // namespace kj
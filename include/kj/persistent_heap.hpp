@@ -0,0 +1,18 @@
+#pragma once
+#include <functional>
+#include <kj/detail/persistent_heap_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the persistent leftist heap (min-heap by default).
+	 *
+	 * Every operation returns a new version sharing structure with the old ones,
+	 * e.g. for k-shortest-path (Eppstein-style) path heaps.
+	 *
+	 * @see kj::detail::PersistentLeftistHeap
+	 */
+	template<class T, class Comp = std::less<T>>
+	using PersistentLeftistHeap = ::kj::detail::PersistentLeftistHeap<T, Comp>;
+
+} // namespace kj
@@ -0,0 +1,17 @@
+#pragma once
+#include <kj/detail/radix_heap_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the monotone radix heap (unsigned keys, min-heap).
+	 *
+	 * Use it instead of a comparison heap when extracted keys never decrease,
+	 * e.g. Dijkstra with non-negative integer weights.
+	 *
+	 * @see kj::detail::RadixHeap
+	 */
+	template<class Key, class Value>
+	using RadixHeap = ::kj::detail::RadixHeap<Key, Value>;
+
+} // namespace kj
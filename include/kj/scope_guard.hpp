@@ -82,6 +82,13 @@ namespace kj {
 			active_ = false;
 		}
 
+		/**
+		 * @brief Returns the stored cleanup function (e.g. to read state captured in it).
+		 */
+		const F& callable() const noexcept {
+			return fn_;
+		}
+
 	private:
 		F fn_;        ///< The cleanup function.
 		bool active_; ///< Whether the guard is currently active.
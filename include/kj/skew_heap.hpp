@@ -19,4 +19,19 @@ namespace kj {
 	template<class T, class Comp = std::less<T>>
 	using SkewHeapArena = ::kj::detail::SkewHeap<T, Comp, /*UsePool=*/true>;
 
+	/**
+	 * @brief Public alias for a skew heap with O(1) @c add_all(delta) via lazy additive tags.
+	 *
+	 * Intended for slope-trick style algorithms that shift all keys of a heap before
+	 * melding it into another one.
+	 */
+	template<class T, class Comp = std::less<T>>
+	using LazySkewHeap = ::kj::detail::SkewHeap<T, Comp, /*UsePool=*/false, /*Lazy=*/true>;
+
+	/**
+	 * @brief Pool-backed variant of @ref LazySkewHeap (same pool sharing rules as SkewHeapArena).
+	 */
+	template<class T, class Comp = std::less<T>>
+	using LazySkewHeapArena = ::kj::detail::SkewHeap<T, Comp, /*UsePool=*/true, /*Lazy=*/true>;
+
 } // namespace kj
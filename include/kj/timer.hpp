@@ -63,11 +63,15 @@ namespace kj {
 	 */
 	class Timer {
 	public:
+		/// Clock used for all measurements (shared with clock-driven utilities such as kj::TimingWheel).
+		/// Monotonic: wall-clock adjustments never shift elapsed times or timer deadlines.
+		using clock = std::chrono::steady_clock;
+
 		/**
 		 * @brief Starts or restarts the timer by recording the current time.
 		 */
 		void start() {
-			start_ = std::chrono::high_resolution_clock::now();
+			start_ = clock::now();
 		}
 
 		/**
@@ -76,7 +80,7 @@ namespace kj {
 		 * @return Elapsed time in milliseconds as a double.
 		 */
 		double stop() {
-			const auto end = std::chrono::high_resolution_clock::now();
+			const auto end = clock::now();
 			return std::chrono::duration<double, std::milli>(end - start_).count();
 		}
 
@@ -86,12 +90,12 @@ namespace kj {
 		 * @return Elapsed duration as a std::chrono::milliseconds object.
 		 */
 		std::chrono::milliseconds elapsed() const {
-			const auto now = std::chrono::high_resolution_clock::now();
+			const auto now = clock::now();
 			return std::chrono::duration_cast<std::chrono::milliseconds>(now - start_);
 		}
 
 	private:
-		std::chrono::high_resolution_clock::time_point start_;  ///< Time point when the timer was started.
+		clock::time_point start_;  ///< Time point when the timer was started.
 	};
 
 } // namespace kj
\ No newline at end of file
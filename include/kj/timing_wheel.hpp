@@ -0,0 +1,16 @@
+#pragma once
+#include <kj/detail/timing_wheel_impl.hpp>
+
+namespace kj {
+
+	/**
+	 * @brief Public alias for the hierarchical timing wheel scheduler.
+	 *
+	 * @see kj::detail::TimingWheel
+	 */
+	template<class Payload>
+	using TimingWheel = ::kj::detail::TimingWheel<Payload>;
+
+	using TimerHandle = ::kj::detail::TimerHandle;
+
+} // namespace kj
@@ -0,0 +1,17 @@
+#pragma once
+#include <functional>
+#include <kj/detail/top_k_impl.hpp>
+
+namespace kj {
+
+	using TopKStrategy = ::kj::detail::TopKStrategy;
+
+	/**
+	 * @brief Public alias for the bounded top-k selector (keeps the k smallest by default).
+	 *
+	 * @see kj::detail::TopK
+	 */
+	template<class T, class Comp = std::less<T>, TopKStrategy Strategy = TopKStrategy::heap>
+	using TopK = ::kj::detail::TopK<T, Comp, Strategy>;
+
+} // namespace kj
@@ -0,0 +1,176 @@
+/**
+ * @file test_addressable_skew_heap.cpp
+ * @brief Unit tests for kj::AddressableSkewHeap<T, Comp>.
+ *
+ * Verifies handles, decrease_key and erase against a std::multiset model,
+ * and a Dijkstra run against a lazy-deletion std::priority_queue.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/addressable_skew_heap.hpp>
+#include <vector>
+#include <set>
+#include <queue>
+#include <utility>
+#include <functional>
+
+/**
+ * @test Verifies push handles, value(), decrease_key and erase on a small heap.
+ */
+TEST_CASE("kj::AddressableSkewHeap handles", "[addressable_skew_heap][basic]") {
+	kj::AddressableSkewHeap<int> h;
+	auto h5 = h.push(5);
+	auto h9 = h.push(9);
+	auto h7 = h.push(7);
+	REQUIRE(h.size() == 3);
+	REQUIRE(h.value(h9) == 9);
+	REQUIRE(h.top() == 5);
+
+	h.decrease_key(h9, 1);
+	REQUIRE(h.top() == 1);
+	REQUIRE(h.top_handle() == h9);
+
+	h.erase(h5);
+	h.erase(h9);
+	REQUIRE(h.size() == 1);
+	REQUIRE(h.top() == 7);
+	REQUIRE(h.top_handle() == h7);
+	h.pop();
+	REQUIRE(h.empty());
+}
+
+/**
+ * @test Verifies a random mix of operations against a multiset model.
+ */
+TEST_CASE("kj::AddressableSkewHeap random operations", "[addressable_skew_heap][random]") {
+	using H = kj::AddressableSkewHeap<int>;
+	H h;
+	std::multiset<int> model;
+	std::vector<H::handle> live;
+
+	unsigned s = 2024;
+	auto rnd = [&](int m) { s = s * 1103515245u + 12345u; return static_cast<int>((s >> 8) % m); };
+
+	for (int step = 0; step < 20000; ++step) {
+		const int op = rnd(10);
+		if (op < 4 || live.empty()) {
+			const int v = rnd(100000);
+			live.push_back(h.push(v));
+			model.insert(v);
+		}
+		else if (op < 6) {
+			const int i = rnd(static_cast<int>(live.size()));
+			const int old = h.value(live[i]);
+			const int v = old - rnd(1000);
+			h.decrease_key(live[i], v);
+			model.erase(model.find(old));
+			model.insert(v);
+		}
+		else if (op < 8) {
+			const int i = rnd(static_cast<int>(live.size()));
+			model.erase(model.find(h.value(live[i])));
+			h.erase(live[i]);
+			live[i] = live.back(); live.pop_back();
+		}
+		else {
+			const auto top = h.top_handle();
+			REQUIRE(h.top() == *model.begin());
+			model.erase(model.begin());
+			for (auto& x : live) if (x == top) { x = live.back(); live.pop_back(); break; }
+			h.pop();
+		}
+		REQUIRE(h.size() == model.size());
+		if (!model.empty()) REQUIRE(h.top() == *model.begin());
+	}
+}
+
+/**
+ * @test Verifies Dijkstra with decrease_key matches the lazy-deletion baseline.
+ */
+TEST_CASE("kj::AddressableSkewHeap Dijkstra", "[addressable_skew_heap][dijkstra]") {
+	const int n = 2000;
+	std::vector<std::vector<std::pair<int, int>>> g(n);
+	unsigned s = 7;
+	auto rnd = [&](int m) { s = s * 1103515245u + 12345u; return static_cast<int>((s >> 8) % m); };
+	for (int e = 0; e < 10 * n; ++e) g[rnd(n)].emplace_back(rnd(n), 1 + rnd(100));
+
+	// Baseline: std::priority_queue with duplicates
+	std::vector<long long> ref(n, -1);
+	{
+		using P = std::pair<long long, int>;
+		std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
+		pq.emplace(0, 0);
+		while (!pq.empty()) {
+			auto [d, u] = pq.top(); pq.pop();
+			if (ref[u] >= 0) continue;
+			ref[u] = d;
+			for (auto [v, w] : g[u]) if (ref[v] < 0) pq.emplace(d + w, v);
+		}
+	}
+
+	using P = std::pair<long long, int>;
+	kj::AddressableSkewHeap<P> h;
+	std::vector<kj::AddressableSkewHeap<P>::handle> where(n);
+	std::vector<long long> dist(n, -1);
+	std::vector<bool> done(n, false);
+	where[0] = h.push(P{ 0, 0 });
+	dist[0] = 0;
+	while (!h.empty()) {
+		auto [d, u] = h.top(); h.pop();
+		done[u] = true;
+		for (auto [v, w] : g[u]) {
+			if (done[v]) continue;
+			if (dist[v] < 0) { dist[v] = d + w; where[v] = h.push(P{ dist[v], v }); }
+			else if (d + w < dist[v]) { dist[v] = d + w; h.decrease_key(where[v], P{ dist[v], v }); }
+		}
+	}
+	REQUIRE(dist == ref);
+}
+
+/**
+ * @test Verifies shared-pool merge keeps handles valid.
+ */
+TEST_CASE("kj::AddressableSkewHeap shared-pool merge", "[addressable_skew_heap][merge]") {
+	using H = kj::AddressableSkewHeap<int>;
+	H::pool_type pool;
+	H a(pool), b(pool);
+	a.push(4);
+	auto hb = b.push(8);
+	b.push(6);
+
+	a.merge(b);
+	REQUIRE(b.empty());
+	REQUIRE(a.size() == 3);
+	a.decrease_key(hb, 1);          // handle from b now refers into a
+	REQUIRE(a.top() == 1);
+}
+
+/**
+ * @test Verifies that move-assigning into a heap keeps its own pool alive for heaps bound to it.
+ */
+TEST_CASE("kj::AddressableSkewHeap move assignment keeps a shared own pool", "[addressable_skew_heap][move]") {
+	using H = kj::AddressableSkewHeap<int>;
+	H src;
+	src.push(1);
+	{
+		H a;
+		a.push(2);
+		H bound(a.pool());                       // shares a's own pool
+		auto h = bound.push(3);
+		bound.push(7);
+
+		a = std::move(src);                      // a's old pool passes to src
+		REQUIRE(a.size() == 1);
+		REQUIRE(a.top() == 1);
+		REQUIRE(src.empty());
+
+		bound.push(5);
+		bound.decrease_key(h, 0);
+		std::vector<int> got;
+		while (!bound.empty()) { got.push_back(bound.top()); bound.pop(); }
+		REQUIRE(got == std::vector<int>{ 0, 5, 7 });
+		REQUIRE(src.pool().live() == 0);
+	}
+	src.push(4);
+	REQUIRE(src.top() == 4);
+}
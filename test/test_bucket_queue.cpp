@@ -0,0 +1,165 @@
+/**
+ * @file test_bucket_queue.cpp
+ * @brief Unit tests for kj::BucketQueue and kj::MonotoneBucketQueue.
+ *
+ * Verifies the 64-ary bit tree, ordering against a std::multiset model,
+ * bucket storage reuse after pop and clear, and the cyclic monotone mode (Dial)
+ * including re-anchoring of an empty queue, and moves.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/bucket_queue.hpp>
+#include <set>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+/**
+ * @test Verifies next/first on a three-level bit tree.
+ */
+TEST_CASE("kj::detail::BitTree64", "[bucket_queue][bits]") {
+	kj::detail::BitTree64<64 * 64 * 4> t;   // 16384 bits -> 3 levels
+	REQUIRE(t.levels == 3);
+	REQUIRE(t.none());
+	REQUIRE(t.first() == t.npos);
+	for (std::size_t i : {5u, 63u, 64u, 4095u, 4096u, 16383u}) t.set(i);
+	REQUIRE(t.first() == 5);
+	REQUIRE(t.next(6) == 63);
+	REQUIRE(t.next(65) == 4095);
+	REQUIRE(t.next(4097) == 16383);
+	t.reset(4095);
+	t.reset(4096);
+	REQUIRE(t.next(65) == 16383);
+	REQUIRE(t.test(16383));
+	REQUIRE_FALSE(t.test(4096));
+	t.reset(16383);
+	REQUIRE(t.next(65) == t.npos);
+}
+
+/**
+ * @test Verifies ordering against a model and storage reuse after clear.
+ */
+TEST_CASE("kj::BucketQueue ordering", "[bucket_queue][model]") {
+	kj::BucketQueue<int> q;
+	REQUIRE(q.bucket_count() == 4096);
+	std::multiset<std::pair<std::uint32_t, int>> model;
+	std::mt19937 rng(8);
+
+	for (int step = 0; step < 30000; ++step) {
+		if (model.empty() || rng() % 3) {
+			const auto p = static_cast<std::uint32_t>(rng() % 4096);
+			q.push(p, step);
+			model.emplace(p, step);
+		}
+		else {
+			const auto p = q.top_priority();
+			REQUIRE(p == model.begin()->first);
+			REQUIRE(model.count({ p, q.top() }) == 1);
+			model.erase(model.find({ p, q.top() }));
+			q.pop();
+		}
+		REQUIRE(q.size() == model.size());
+	}
+
+	q.clear();
+	REQUIRE(q.empty());
+	q.push(4095, 1);
+	q.push(0, 2);
+	q.push(0, 3);
+	REQUIRE(q.top() == 3);   // LIFO within a bucket
+	q.pop();
+	REQUIRE(q.top() == 2);
+	q.pop();
+	REQUIRE(q.top_priority() == 4095);
+
+	// emptied and cleared buckets keep their storage
+	kj::BucketQueue<int> r;
+	r.push(7, 1);
+	const int* slot = &r.top();
+	r.pop();
+	r.push(7, 2);
+	REQUIRE(&r.top() == slot);
+	r.clear();
+	r.push(7, 3);
+	REQUIRE(&r.top() == slot);
+
+	kj::BucketQueue<std::string, 128> s;
+	s.push(100, "late");
+	s.emplace(3, 2, 'x');
+	REQUIRE(s.top() == "xx");
+}
+
+/**
+ * @test Verifies the cyclic window of the monotone queue across wrap-arounds.
+ */
+TEST_CASE("kj::MonotoneBucketQueue (Dial)", "[bucket_queue][monotone]") {
+	kj::MonotoneBucketQueue<int, 256> q;
+	std::multiset<std::uint64_t> model;
+	std::mt19937 rng(4);
+	std::uint64_t last = 0;
+
+	for (int step = 0; step < 50000; ++step) {
+		if (model.empty() || rng() % 2) {
+			const std::uint64_t p = last + rng() % 256;   // within [last, last + N)
+			q.push(p, step);
+			model.insert(p);
+		}
+		else {
+			REQUIRE(q.top_priority() == *model.begin());
+			last = *model.begin();
+			model.erase(model.begin());
+			q.pop();
+		}
+	}
+	REQUIRE(last > 100 * 256);   // many wrap-arounds
+	while (!model.empty()) {
+		REQUIRE(q.top_priority() == *model.begin());
+		model.erase(model.begin());
+		q.pop();
+	}
+	REQUIRE(q.empty());
+
+	// an empty queue re-anchors its window at the next push
+	q.push(last + 1000000, 1);
+	q.push(last + 1000000 + 255, 2);
+	REQUIRE(q.top_priority() == last + 1000000);
+	q.clear();
+	q.push(5, 3);
+	q.push(200, 4);
+	REQUIRE(q.top() == 3);
+	q.pop();
+	REQUIRE(q.top_priority() == 200);
+	q.pop();
+	q.push(1, 5);                                   // below the old minimum, queue empty
+	REQUIRE(q.top_priority() == 1);
+}
+
+/**
+ * @test Verifies that queues are small, movable, and usable again after being moved from.
+ */
+TEST_CASE("kj::BucketQueue move", "[bucket_queue][move]") {
+	REQUIRE(sizeof(kj::BucketQueue<std::string>) < 1024);
+	REQUIRE(std::is_nothrow_move_constructible_v<kj::MonotoneBucketQueue<int>>);
+
+	kj::MonotoneBucketQueue<std::string> a;
+	a.push(70, "b");
+	a.push(40, "a");
+	auto b = std::move(a);
+	REQUIRE(a.empty());
+	REQUIRE(b.size() == 2);
+	REQUIRE(b.top_priority() == 40);
+
+	a.push(3, "c");                                 // the moved-from queue starts over
+	REQUIRE(a.top() == "c");
+	a = std::move(b);
+	REQUIRE(b.empty());
+	REQUIRE(a.size() == 2);
+	REQUIRE(a.top() == "a");
+	a.pop();
+	REQUIRE(a.top() == "b");
+	b.push(9, "d");
+	b.clear();
+	REQUIRE(b.empty());
+}
@@ -0,0 +1,109 @@
+/**
+ * @file test_ccl.cpp
+ * @brief Unit tests for kj::label_components / kj::label_components_bits.
+ *
+ * Verifies run-based labeling against a flood-fill reference for byte and bit grids,
+ * both connectivities, and the band-parallel mode.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/ccl.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+	/// Flood-fill reference; seeds in raster order give the same numbering as kj.
+	std::vector<int> flood_labels(const std::vector<std::uint8_t>& g, int w, int h, bool eight, int& count) {
+		std::vector<int> lab(g.size(), 0), stk;
+		count = 0;
+		for (int i = 0; i < w * h; ++i) {
+			if (!g[i] || lab[i]) continue;
+			lab[i] = ++count;
+			stk.push_back(i);
+			while (!stk.empty()) {
+				const int c = stk.back(); stk.pop_back();
+				const int cx = c % w, cy = c / w;
+				for (int dy = -1; dy <= 1; ++dy) {
+					for (int dx = -1; dx <= 1; ++dx) {
+						if ((dx || dy) && (eight || !(dx && dy))) {
+							const int x = cx + dx, y = cy + dy;
+							if (x < 0 || y < 0 || x >= w || y >= h) continue;
+							const int j = y * w + x;
+							if (g[j] && !lab[j]) { lab[j] = count; stk.push_back(j); }
+						}
+					}
+				}
+			}
+		}
+		return lab;
+	}
+
+	std::vector<std::uint8_t> random_grid(int w, int h, unsigned seed, int density) {
+		std::vector<std::uint8_t> g(static_cast<std::size_t>(w) * h);
+		for (auto& c : g) { seed = seed * 1103515245u + 12345u; c = ((seed >> 8) % 100) < static_cast<unsigned>(density); }
+		return g;
+	}
+
+} // namespace
+
+/**
+ * @test Verifies a hand-made grid where 4- and 8-connectivity differ.
+ */
+TEST_CASE("kj::label_components diagonal contact", "[ccl][basic]") {
+	const std::vector<std::uint8_t> g = {
+		1, 0, 0, 1,
+		0, 1, 0, 1,
+		0, 0, 0, 0,
+	};
+	std::vector<int> lab(g.size());
+
+	REQUIRE(kj::label_components(std::span<const std::uint8_t>(g), 4, 3, lab, kj::Connectivity::four) == 3);
+	REQUIRE(lab == std::vector<int>({ 1, 0, 0, 2, 0, 3, 0, 2, 0, 0, 0, 0 }));
+
+	REQUIRE(kj::label_components(std::span<const std::uint8_t>(g), 4, 3, lab, kj::Connectivity::eight) == 2);
+	REQUIRE(lab == std::vector<int>({ 1, 0, 0, 2, 0, 1, 0, 2, 0, 0, 0, 0 }));
+
+	// containers are accepted directly
+	std::fill(lab.begin(), lab.end(), -1);
+	REQUIRE(kj::label_components(g, 4, 3, lab) == 3);
+	REQUIRE(lab == std::vector<int>({ 1, 0, 0, 2, 0, 3, 0, 2, 0, 0, 0, 0 }));
+}
+
+/**
+ * @test Verifies byte and bit grids against flood fill, sequential and band-parallel.
+ */
+TEST_CASE("kj::label_components matches flood fill", "[ccl][random]") {
+	const int w = 77, h = 53;
+	for (int density : { 30, 55, 70 }) {
+		const auto g = random_grid(w, h, 1000u + density, density);
+
+		// Packed copy of the same grid
+		const int stride = (w + 63) / 64;
+		kj::Buffer<std::uint64_t> bits(static_cast<std::size_t>(stride) * h);
+		for (std::size_t i = 0; i < bits.size(); ++i) bits[i] = 0;
+		for (int y = 0; y < h; ++y)
+			for (int x = 0; x < w; ++x)
+				if (g[y * w + x]) bits[y * stride + x / 64] |= std::uint64_t{ 1 } << (x % 64);
+
+		kj::Buffer<std::uint8_t> pix(g.size());
+		for (std::size_t i = 0; i < g.size(); ++i) pix[i] = g[i];
+
+		for (bool eight : { false, true }) {
+			const auto conn = eight ? kj::Connectivity::eight : kj::Connectivity::four;
+			int expect_count = 0;
+			const auto expect = flood_labels(g, w, h, eight, expect_count);
+
+			for (unsigned threads : { 1u, 3u }) {
+				kj::Buffer<int> lab(g.size());
+				REQUIRE(kj::label_components(pix, w, h, lab, conn, threads) == expect_count);
+				REQUIRE(std::vector<int>(lab.data(), lab.data() + lab.size()) == expect);
+
+				kj::Buffer<int> lab2(g.size());
+				REQUIRE(kj::label_components_bits(bits, w, h, lab2, conn, threads) == expect_count);
+				REQUIRE(std::vector<int>(lab2.data(), lab2.data() + lab2.size()) == expect);
+			}
+		}
+	}
+}
@@ -0,0 +1,223 @@
+/**
+ * @file test_dary_heap.cpp
+ * @brief Unit tests for kj::DaryHeap<T, Comp, D> and kj::IndexedDaryHeap<T, Comp, D>.
+ *
+ * Verifies ordering for several arities (vectorized and generic child scans),
+ * bulk heapify, buffer alignment, non-trivial keys, and id-based
+ * decrease_key / erase against a std::multiset model.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/dary_heap.hpp>
+#include <vector>
+#include <set>
+#include <string>
+#include <stdexcept>
+#include <memory>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+#include <functional>
+
+namespace {
+	template <class Heap, class T>
+	std::vector<T> drain(Heap& h) {
+		std::vector<T> out;
+		while (!h.empty()) { out.push_back(h.top()); h.pop(); }
+		return out;
+	}
+
+	template <std::size_t D>
+	void check_random_order() {
+		std::mt19937 rng(static_cast<unsigned>(D));
+		std::vector<int> v(1000);
+		for (auto& x : v) x = static_cast<int>(rng() % 200);   // many duplicates
+
+		kj::DaryHeap<int, std::less<int>, D> h;
+		for (int x : v) h.push(x);
+		std::vector<int> want = v;
+		std::sort(want.begin(), want.end());
+		REQUIRE(drain<decltype(h), int>(h) == want);
+
+		kj::DaryHeap<int, std::greater<>, D> m(v.begin(), v.end());
+		std::sort(want.begin(), want.end(), std::greater<>{});
+		REQUIRE(drain<decltype(m), int>(m) == want);
+	}
+}
+
+/**
+ * @test Verifies min-heap and max-heap ordering for several arities.
+ */
+TEST_CASE("kj::DaryHeap ordering", "[dary_heap][basic]") {
+	kj::DaryHeap<int> h;
+	REQUIRE(h.empty());
+	for (int x : {5, 3, 7, 2, 9, 1, 8}) h.push(x);
+	REQUIRE(h.size() == 7);
+	REQUIRE(h.top() == 1);
+	REQUIRE(drain<decltype(h), int>(h) == std::vector<int>({ 1, 2, 3, 5, 7, 8, 9 }));
+
+	check_random_order<2>();
+	check_random_order<4>();
+	check_random_order<8>();
+	check_random_order<16>();
+
+	kj::DaryHeap<double, std::less<double>, 8> d;
+	for (double x : {2.5, -1.0, 3.25, 0.0}) d.push(x);
+	REQUIRE(d.top() == -1.0);
+}
+
+/**
+ * @test Verifies bulk heapify, push_range and buffer alignment.
+ */
+TEST_CASE("kj::DaryHeap bulk build", "[dary_heap][bulk]") {
+	std::vector<int> v(5000);
+	for (int i = 0; i < 5000; ++i) v[static_cast<std::size_t>(i)] = (i * 7919) % 5000;
+
+	kj::DaryHeap<int, std::less<int>, 16> h(v.begin(), v.end());
+	REQUIRE(h.size() == 5000);
+	REQUIRE(h.capacity() >= 5000);
+	REQUIRE(reinterpret_cast<std::uintptr_t>(&h.top() + 1) % 64 == 0);   // first child group starts a cache line
+
+	// small batch (sift-up path) and large batch (heapify path)
+	std::vector<int> few = { -3, -1, -2 };
+	h.push_range(few.begin(), few.end());
+	std::vector<int> many(20000, 7);
+	h.push_range(many.begin(), many.end());
+	REQUIRE(h.size() == 25003);
+
+	std::vector<int> got = drain<decltype(h), int>(h);
+	REQUIRE(std::is_sorted(got.begin(), got.end()));
+	REQUIRE(got.front() == -3);
+
+	h.push(4);
+	h.clear();
+	REQUIRE(h.empty());
+}
+
+/**
+ * @test Verifies non-trivial keys survive growth, moves and clear.
+ */
+TEST_CASE("kj::DaryHeap non-trivial keys", "[dary_heap][types]") {
+	kj::DaryHeap<std::string, std::less<std::string>, 4> h;
+	for (int i = 0; i < 300; ++i) h.emplace(std::to_string((i * 37) % 300));
+	auto moved = std::move(h);
+	REQUIRE(h.empty());
+	REQUIRE(moved.top() == "0");
+
+	kj::DaryHeap<std::unique_ptr<int>, std::function<bool(const std::unique_ptr<int>&, const std::unique_ptr<int>&)>, 4>
+		p([](const auto& a, const auto& b) { return *a < *b; });
+	for (int i = 10; i > 0; --i) p.push(std::make_unique<int>(i));
+	REQUIRE(*p.top() == 1);
+	p.pop();
+	REQUIRE(*p.top() == 2);
+	p.clear();
+	REQUIRE(p.empty());
+}
+
+namespace {
+	// Copy throws once a global budget is used up; live instances are counted.
+	struct Fragile {
+		static inline int budget = -1;
+		static inline int live = 0;
+		int v = 0;
+		explicit Fragile(int x) : v(x) { ++live; }
+		Fragile(const Fragile& o) : v(o.v) {
+			if (budget-- == 0) throw std::runtime_error("copy");
+			++live;
+		}
+		Fragile(Fragile&& o) noexcept : v(o.v) { ++live; }
+		Fragile& operator=(const Fragile&) = default;
+		Fragile& operator=(Fragile&&) noexcept = default;
+		~Fragile() { --live; }
+		bool operator<(const Fragile& o) const noexcept { return v < o.v; }
+	};
+}
+
+/**
+ * @test Verifies that a throwing copy in push_range leaves a valid heap on both paths.
+ */
+TEST_CASE("kj::DaryHeap push_range is exception safe", "[dary_heap][bulk]") {
+	{
+		kj::DaryHeap<Fragile, std::less<Fragile>, 4> h;
+		for (int x : { 9, 4, 6, 1 }) h.emplace(x);
+		std::vector<Fragile> src;
+		for (int i = 0; i < 100; ++i) src.emplace_back(100 - i);
+		const int before = Fragile::live;
+
+		Fragile::budget = 50;                     // bulk path: the batch is dropped
+		bool threw = false;
+		try { h.push_range(src.begin(), src.end()); }
+		catch (const std::runtime_error&) { threw = true; }
+		REQUIRE(threw);
+		REQUIRE(h.size() == 4);
+		REQUIRE(Fragile::live == before);
+
+		h.push_range(src.begin(), src.begin() + 40);
+		Fragile::budget = 5;                      // sift-up path: the copied prefix stays
+		threw = false;
+		try { h.push_range(src.begin() + 40, src.begin() + 50); }
+		catch (const std::runtime_error&) { threw = true; }
+		Fragile::budget = -1;
+		REQUIRE(threw);
+		REQUIRE(h.size() == 49);
+
+		std::vector<int> got;
+		while (!h.empty()) { got.push_back(h.top().v); h.pop(); }
+		REQUIRE(std::is_sorted(got.begin(), got.end()));
+		REQUIRE(got.front() == 1);
+		REQUIRE(got.back() == 100);
+	}
+	REQUIRE(Fragile::live == 0);
+}
+
+/**
+ * @test Verifies id-based decrease_key, erase and contains against a model.
+ */
+TEST_CASE("kj::IndexedDaryHeap decrease_key", "[dary_heap][indexed]") {
+	kj::IndexedDaryHeap<int> h;
+	std::vector<int> key(500, -1);
+	std::multiset<std::pair<int, int>> model;
+	std::mt19937 rng(7);
+
+	for (int id = 0; id < 500; ++id) {
+		key[static_cast<std::size_t>(id)] = static_cast<int>(rng() % 100000);
+		h.push(id, key[static_cast<std::size_t>(id)]);
+		model.emplace(key[static_cast<std::size_t>(id)], id);
+	}
+	REQUIRE(h.contains(123));
+	REQUIRE_FALSE(h.contains(500));
+
+	for (int step = 0; step < 2000 && !model.empty(); ++step) {
+		const int id = static_cast<int>(rng() % 500);
+		const auto uid = static_cast<std::size_t>(id);
+		const unsigned op = rng() % 3;
+		if (!h.contains(id)) continue;
+		REQUIRE(h.key(id) == key[uid]);
+		model.erase(model.find({ key[uid], id }));
+		if (op == 0) {
+			key[uid] -= static_cast<int>(rng() % 1000);
+			h.decrease_key(id, key[uid]);
+			model.emplace(key[uid], id);
+		}
+		else if (op == 1) {
+			h.erase(id);
+		}
+		else {
+			model.emplace(key[uid], id);
+			const int top = h.top_id();
+			REQUIRE(h.contains(top));
+			REQUIRE(h.top() == model.begin()->first);
+			model.erase(model.find({ h.top(), top }));
+			h.pop();
+			REQUIRE_FALSE(h.contains(top));
+		}
+		REQUIRE(h.size() == model.size());
+		if (!model.empty()) REQUIRE(h.top() == model.begin()->first);
+	}
+
+	h.clear();
+	REQUIRE(h.empty());
+	REQUIRE_FALSE(h.contains(0));
+	h.push(0, 1);
+	REQUIRE(h.top_id() == 0);
+}
@@ -7,6 +7,10 @@
 
 #include <catch2/catch_all.hpp>
 #include <kj/dsu.hpp>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <type_traits>
 
  /**
   * @test Verifies that DSU connects components and reports sizes correctly.
@@ -81,3 +85,220 @@ TEST_CASE("kj::RollbackDSU snapshot/rollback", "[dsu][rollback]") {
 	REQUIRE_FALSE(d.same(0, 1));
 	REQUIRE_FALSE(d.same(3, 4));
 }
+
+/**
+ * @test Verifies that DSU::absorb joins two partitions without touching the donor.
+ */
+TEST_CASE("kj::DSU absorb joins partitions", "[dsu][absorb]") {
+	kj::DSU a(6), b(6);
+	REQUIRE(a.unite(0, 1));
+	REQUIRE(a.unite(4, 5));
+	REQUIRE(b.unite(1, 2));
+	REQUIRE(b.unite(2, 3));
+
+	REQUIRE(a.absorb(b) == 2);
+	REQUIRE(a.same(0, 3));
+	REQUIRE(a.size(0) == 4);
+	REQUIRE(a.same(4, 5));
+	REQUIRE_FALSE(a.same(3, 4));
+
+	// Donor keeps its own partition
+	REQUIRE_FALSE(b.same(0, 1));
+	REQUIRE(b.same(1, 3));
+
+	// Absorbing again is a no-op
+	REQUIRE(a.absorb(b) == 0);
+}
+
+/**
+ * @test Verifies that merge_shards matches replaying all edges into one DSU.
+ */
+TEST_CASE("kj::merge_shards tree-reduces shard states", "[dsu][absorb][parallel]") {
+	const int n = 1000, k = 7;
+	std::vector<kj::DSU> shards(k, kj::DSU(n));
+	kj::DSU ref(n);
+
+	unsigned s = 12345;
+	for (int e = 0; e < 600; ++e) {
+		s = s * 1103515245u + 12345u; int u = static_cast<int>((s >> 8) % n);
+		s = s * 1103515245u + 12345u; int v = static_cast<int>((s >> 8) % n);
+		shards[e % k].unite(u, v);
+		ref.unite(u, v);
+	}
+
+	kj::merge_shards(shards, 4);
+	for (int i = 0; i < n; ++i) {
+		REQUIRE(shards[0].size(i) == ref.size(i));
+		REQUIRE(shards[0].same(i, ref.find(i)));
+	}
+}
+
+/**
+ * @test Verifies ParityDSU 2-coloring and odd-cycle detection.
+ */
+TEST_CASE("kj::ParityDSU colors and detects odd cycles", "[dsu][parity]") {
+	kj::ParityDSU d(6);
+
+	// Even cycle 0-1-2-3-0 is bipartite
+	REQUIRE(d.unite(0, 1));
+	REQUIRE(d.unite(1, 2));
+	REQUIRE(d.unite(2, 3));
+	REQUIRE(d.unite(3, 0));
+	REQUIRE(d.bipartite());
+	REQUIRE(d.size(0) == 4);
+	REQUIRE(d.color(0) != d.color(1));
+	REQUIRE(d.color(0) == d.color(2));
+	REQUIRE(d.color(1) == d.color(3));
+
+	// Equality constraint
+	REQUIRE(d.unite(4, 0, false));
+	REQUIRE(d.color(4) == d.color(0));
+
+	// Odd cycle 0-4-... : 4 equals 0, so edge 4-2 (2 has 0's color) is a conflict
+	REQUIRE_FALSE(d.unite(4, 2));
+	REQUIRE_FALSE(d.bipartite());
+	REQUIRE(d.conflict == std::pair<int, int>(4, 2));
+
+	// Later conflicts do not overwrite the first one
+	REQUIRE_FALSE(d.unite(1, 3));
+	REQUIRE(d.conflict == std::pair<int, int>(4, 2));
+
+	d.reset(6);
+	REQUIRE(d.bipartite());
+	REQUIRE_FALSE(d.same(0, 1));
+}
+
+/**
+ * @test Verifies TimedDSU connection times against brute-force replay.
+ */
+TEST_CASE("kj::TimedDSU connected_time matches replay", "[dsu][timed]") {
+	const int n = 40, m = 60;
+	std::vector<std::pair<int, int>> edges;
+	unsigned s = 777;
+	for (int e = 0; e < m; ++e) {
+		s = s * 1103515245u + 12345u; int u = static_cast<int>((s >> 8) % n);
+		s = s * 1103515245u + 12345u; int v = static_cast<int>((s >> 8) % n);
+		edges.emplace_back(u, v);
+	}
+
+	kj::TimedDSU d(n);
+	for (auto [u, v] : edges) d.unite(u, v);
+	REQUIRE(d.now == static_cast<std::uint32_t>(m));
+
+	// Reference: first prefix length after which a and b are connected
+	std::vector<std::pair<int, int>> queries;
+	std::vector<std::uint32_t> expect;
+	for (int a = 0; a < n; a += 3) {
+		for (int b = 0; b < n; b += 5) {
+			std::uint32_t t = (a == b) ? 0 : kj::TimedDSU::never;
+			kj::DSU ref(n);
+			for (int e = 0; e < m && t == kj::TimedDSU::never; ++e) {
+				ref.unite(edges[e].first, edges[e].second);
+				if (ref.same(a, b)) t = static_cast<std::uint32_t>(e);
+			}
+			REQUIRE(d.connected_time(a, b) == t);
+			queries.emplace_back(a, b);
+			expect.push_back(t);
+		}
+	}
+
+	std::vector<std::uint32_t> got(queries.size());
+	d.connected_time(queries, got);
+	REQUIRE(got == expect);
+}
+
+/**
+ * @test Verifies RollbackTransaction rollback on exit, commit, and nesting.
+ */
+TEST_CASE("kj::RollbackTransaction scopes", "[dsu][rollback][transaction]") {
+	kj::RollbackDSU d(6);
+
+	{
+		kj::RollbackTransaction tx(d);
+		REQUIRE(tx.token() == 0);
+		REQUIRE(d.unite(0, 1));
+	} // not committed
+	REQUIRE_FALSE(d.same(0, 1));
+	REQUIRE(d.snapshot() == 0);
+
+	{
+		kj::RollbackTransaction outer(d);
+		REQUIRE(d.unite(0, 1));
+		{
+			kj::RollbackTransaction inner(d);
+			REQUIRE(d.unite(2, 3));
+			inner.commit();
+		}
+		{
+			kj::RollbackTransaction inner(d);
+			REQUIRE(d.unite(4, 5));
+		} // rolled back
+		REQUIRE(d.same(2, 3));
+		REQUIRE_FALSE(d.same(4, 5));
+		outer.commit();
+	}
+	REQUIRE(d.same(0, 1));
+	REQUIRE(d.same(2, 3));
+
+	{
+		kj::RollbackTransaction tx(d);
+		REQUIRE(d.unite(1, 2));
+	} // outer-level rollback keeps earlier committed work
+	REQUIRE(d.same(0, 1));
+	REQUIRE_FALSE(d.same(1, 2));
+}
+
+/**
+ * @test Verifies FixedDSU in constant evaluation and at run time.
+ */
+TEST_CASE("kj::FixedDSU constexpr and runtime", "[dsu][fixed]") {
+	static_assert(std::is_same_v<kj::FixedDSU<64>::index_type, std::int8_t>);
+	static_assert(std::is_same_v<kj::FixedDSU<256>::index_type, std::int16_t>);
+	static_assert(std::is_same_v<kj::FixedDSU<40000>::index_type, std::int32_t>);
+	static_assert(sizeof(kj::FixedDSU<64>) == 64);
+
+	constexpr int comp = [] {
+		kj::FixedDSU<8> d;
+		d.unite(0, 1);
+		d.unite(2, 3);
+		d.unite(1, 3);
+		return d.size(2) * 10 + static_cast<int>(d.same(0, 3));
+	}();
+	static_assert(comp == 41);
+
+	kj::FixedDSU<100> d;
+	for (int i = 0; i + 1 < 100; i += 2) REQUIRE(d.unite(i, i + 1));
+	REQUIRE_FALSE(d.unite(0, 1));
+	REQUIRE(d.size(10) == 2);
+	d.reset();
+	for (int i = 0; i < 100; ++i) REQUIRE(d.size(i) == 1);
+}
+
+/**
+ * @test Verifies InstrumentedDSU counters and that the default DSU carries no state.
+ */
+TEST_CASE("kj::InstrumentedDSU counts operations and path lengths", "[dsu][stats]") {
+	static_assert(sizeof(kj::DSU) == sizeof(std::vector<int>));
+
+	kj::InstrumentedDSU d(4);
+	// Build the chain 3 -> 2 -> 0 by hand to get a known path
+	d.p = { -3, -1, 0, 2 };
+
+	REQUIRE(d.find(3) == 0);                 // visits 2 links, rewrites p[3]
+	auto s = d.stats.snapshot();
+	REQUIRE(s.finds == 1);
+	REQUIRE(s.visited == 2);
+	REQUIRE(s.compress_writes == 1);
+	REQUIRE(s.path_hist[2] == 1);
+
+	REQUIRE(d.unite(1, 3));                  // two finds: 1 (root), 3 (one link)
+	REQUIRE_FALSE(d.unite(0, 1));
+	s = d.stats.snapshot();
+	REQUIRE(s.unites == 2);
+	REQUIRE(s.merges == 1);
+	REQUIRE(s.finds == 5);
+	REQUIRE(s.path_hist[0] + s.path_hist[1] + s.path_hist[2] == 5);
+
+	d.stats.clear();
+	REQUIRE(d.stats.snapshot().finds == 0);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file test_kway_merge.cpp
+ * @brief Unit tests for kj::meld_all and kj::merge_runs.
+ *
+ * Verifies tournament melding of heaps (sequential and parallel) and the
+ * loser-tree merge of sorted views against std::stable_sort, including
+ * stability, empty runs and parallel splitting.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/kway_merge.hpp>
+#include <kj/skew_heap.hpp>
+#include <kj/pairing_heap.hpp>
+#include <vector>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+/**
+ * @test Verifies that meld_all collects every element into the first heap.
+ */
+TEST_CASE("kj::meld_all", "[kway_merge][heaps]") {
+	for (unsigned threads : {1u, 4u}) {
+		std::vector<kj::SkewHeap<int>> heaps(37);
+		for (int i = 0; i < 3700; ++i) heaps[static_cast<std::size_t>(i % 37)].push((i * 7919) % 3700);
+		kj::meld_all(heaps, threads);
+		REQUIRE(heaps[0].size() == 3700);
+		for (std::size_t i = 1; i < heaps.size(); ++i) REQUIRE(heaps[i].empty());
+		for (int i = 0; i < 3700; ++i) { REQUIRE(heaps[0].top() == i); heaps[0].pop(); }
+	}
+
+	kj::PairingHeap<int>::pool_type pool;
+	std::vector<kj::PairingHeap<int>> shared;
+	for (int i = 0; i < 5; ++i) { shared.emplace_back(pool); shared.back().push(10 - i); }
+	kj::meld_all(std::span<kj::PairingHeap<int>>(shared));   // shared pool: sequential only
+	REQUIRE(shared[0].size() == 5);
+	REQUIRE(shared[0].top() == 6);
+
+	std::vector<kj::SkewHeap<int>> none;
+	kj::meld_all(none);
+}
+
+/**
+ * @test Verifies the loser-tree merge against std::stable_sort, sequential and split.
+ */
+TEST_CASE("kj::merge_runs", "[kway_merge][runs]") {
+	using P = std::pair<int, int>;   // (key, run id) to check stability
+	auto by_key = [](const P& a, const P& b) { return a.first < b.first; };
+	std::mt19937 rng(5);
+
+	for (std::size_t k : {1u, 2u, 3u, 17u, 64u}) {
+		std::vector<std::vector<P>> data(k);
+		for (std::size_t r = 0; r < k; ++r) {
+			const std::size_t len = (r % 5 == 3) ? 0 : rng() % 2000;   // some empty runs
+			for (std::size_t i = 0; i < len; ++i) data[r].emplace_back(static_cast<int>(rng() % 500), static_cast<int>(r));
+			std::stable_sort(data[r].begin(), data[r].end(), by_key);
+		}
+		std::vector<kj::ConstView<P>> runs;
+		std::vector<P> want;
+		for (auto& d : data) { runs.emplace_back(d); want.insert(want.end(), d.begin(), d.end()); }
+		std::stable_sort(want.begin(), want.end(), by_key);
+
+		for (unsigned threads : {1u, 3u, 8u}) {
+			std::vector<P> out(want.size() + 2, P{ -1, -1 });
+			REQUIRE(kj::merge_runs<P>(runs, out, by_key, threads) == want.size());
+			REQUIRE(std::equal(want.begin(), want.end(), out.begin()));
+			REQUIRE(out.back() == P{ -1, -1 });
+		}
+	}
+
+	std::vector<int> a = { 9, 5, 1 }, b = { 8, 2 };
+	std::vector<kj::ConstView<int>> desc = { a, b };
+	std::vector<int> out(5);
+	kj::merge_runs<int>(desc, out, std::greater<int>{});
+	REQUIRE(out == std::vector<int>({ 9, 8, 5, 2, 1 }));
+	REQUIRE(kj::merge_runs<int>({}, {}) == 0);
+}
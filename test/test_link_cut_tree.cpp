@@ -0,0 +1,106 @@
+/**
+ * @file test_link_cut_tree.cpp
+ * @brief Unit tests for kj::LinkCutTree.
+ *
+ * Verifies link/cut/connected against a brute-force forest, and path aggregates.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/link_cut_tree.hpp>
+#include <vector>
+#include <set>
+#include <utility>
+
+namespace {
+
+	/// Brute-force forest: edge set + DFS path search.
+	struct NaiveForest {
+		std::vector<std::set<int>> adj;
+		explicit NaiveForest(int n) : adj(n) {}
+
+		bool path(int u, int v, std::vector<int>& out, int from = -1) const {
+			out.push_back(u);
+			if (u == v) return true;
+			for (int w : adj[u]) {
+				if (w != from && path(w, v, out, u)) return true;
+			}
+			out.pop_back();
+			return false;
+		}
+	};
+
+} // namespace
+
+/**
+ * @test Verifies basic link, cut and connectivity on a small forest.
+ */
+TEST_CASE("kj::LinkCutTree link/cut/connected", "[link_cut_tree][basic]") {
+	kj::LinkCutTree<> t(5);
+	REQUIRE(t.universe() == 5);
+	REQUIRE_FALSE(t.connected(0, 1));
+
+	REQUIRE(t.link(0, 1));
+	REQUIRE(t.link(1, 2));
+	REQUIRE(t.link(3, 4));
+	REQUIRE(t.connected(0, 2));
+	REQUIRE_FALSE(t.connected(2, 3));
+	REQUIRE_FALSE(t.link(2, 0));   // would create a cycle
+
+	REQUIRE_FALSE(t.cut(0, 2));    // not an edge
+	REQUIRE(t.cut(1, 2));
+	REQUIRE_FALSE(t.connected(0, 2));
+	REQUIRE(t.connected(0, 1));
+
+	t.make_root(2);
+	REQUIRE(t.find_root(2) == 2);
+	REQUIRE(t.link(2, 3));
+	REQUIRE(t.connected(2, 4));
+}
+
+/**
+ * @test Verifies random link/cut/make_root sequences and path sums against brute force.
+ */
+TEST_CASE("kj::LinkCutTree random forest with path sums", "[link_cut_tree][aggregate]") {
+	const int n = 30;
+	kj::LinkCutTree<long long> t(n);
+	NaiveForest ref(n);
+	std::vector<long long> val(n);
+	for (int i = 0; i < n; ++i) { val[i] = i * 7 % 11; t.set(i, val[i]); }
+
+	unsigned s = 4242;
+	auto rnd = [&](int m) { s = s * 1103515245u + 12345u; return static_cast<int>((s >> 8) % m); };
+
+	for (int step = 0; step < 3000; ++step) {
+		const int u = rnd(n), v = rnd(n);
+		std::vector<int> p;
+		const bool conn = ref.path(u, v, p);
+		REQUIRE(t.connected(u, v) == conn);
+
+		switch (rnd(4)) {
+		case 0:
+			if (u != v && !conn) { REQUIRE(t.link(u, v)); ref.adj[u].insert(v); ref.adj[v].insert(u); }
+			else REQUIRE_FALSE(t.link(u, v));
+			break;
+		case 1:
+			if (ref.adj[u].count(v)) { REQUIRE(t.cut(u, v)); ref.adj[u].erase(v); ref.adj[v].erase(u); }
+			else REQUIRE_FALSE(t.cut(u, v));
+			break;
+		case 2:
+			val[u] = rnd(100);
+			t.set(u, val[u]);
+			REQUIRE(t.get(u) == val[u]);
+			if (rnd(3) == 0) {                 // cut works on either orientation of an edge
+				t.make_root(v);
+				REQUIRE(t.find_root(v) == v);
+			}
+			break;
+		default:
+			if (conn) {
+				long long sum = 0;
+				for (int x : p) sum += val[x];
+				REQUIRE(t.path_aggregate(u, v) == sum);
+			}
+			break;
+		}
+	}
+}
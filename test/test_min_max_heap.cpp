@@ -0,0 +1,89 @@
+/**
+ * @file test_min_max_heap.cpp
+ * @brief Unit tests for kj::MinMaxHeap<T, Comp>.
+ *
+ * Verifies both ends against a std::multiset model under random operations,
+ * bulk construction, custom comparators and non-trivial keys.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/min_max_heap.hpp>
+#include <set>
+#include <vector>
+#include <string>
+#include <random>
+#include <iterator>
+#include <functional>
+
+/**
+ * @test Verifies basic double-ended access.
+ */
+TEST_CASE("kj::MinMaxHeap basics", "[min_max_heap][basic]") {
+	kj::MinMaxHeap<int> h;
+	REQUIRE(h.empty());
+	h.push(5);
+	REQUIRE(h.top_min() == 5);
+	REQUIRE(h.top_max() == 5);
+	for (int x : {3, 9, 1, 7}) h.push(x);
+	REQUIRE(h.size() == 5);
+	REQUIRE(h.top_min() == 1);
+	REQUIRE(h.top_max() == 9);
+	h.pop_max();
+	REQUIRE(h.top_max() == 7);
+	h.pop_min();
+	REQUIRE(h.top_min() == 3);
+	h.clear();
+	REQUIRE(h.empty());
+
+	kj::MinMaxHeap<std::string, std::greater<std::string>> g;   // reversed convention
+	for (const char* s : { "b", "d", "a", "c" }) g.emplace(s);
+	REQUIRE(g.top_min() == "d");
+	REQUIRE(g.top_max() == "a");
+}
+
+/**
+ * @test Verifies random push/pop_min/pop_max against a model, after bulk build too.
+ */
+TEST_CASE("kj::MinMaxHeap random model", "[min_max_heap][model]") {
+	std::mt19937 rng(21);
+	std::vector<int> init(3000);
+	for (auto& x : init) x = static_cast<int>(rng() % 1000);
+
+	kj::MinMaxHeap<int> h(init.begin(), init.end());
+	std::multiset<int> model(init.begin(), init.end());
+	REQUIRE(h.size() == model.size());
+
+	for (int step = 0; step < 20000; ++step) {
+		const unsigned op = rng() % 4;
+		if (op <= 1 || model.empty()) {
+			const int x = static_cast<int>(rng() % 1000);
+			h.push(x);
+			model.insert(x);
+		}
+		else if (op == 2) {
+			REQUIRE(h.top_min() == *model.begin());
+			h.pop_min();
+			model.erase(model.begin());
+		}
+		else {
+			REQUIRE(h.top_max() == *model.rbegin());
+			h.pop_max();
+			model.erase(std::prev(model.end()));
+		}
+		REQUIRE(h.size() == model.size());
+		if (!model.empty()) {
+			REQUIRE(h.top_min() == *model.begin());
+			REQUIRE(h.top_max() == *model.rbegin());
+		}
+	}
+
+	std::vector<int> more(500, 42);
+	h.push_range(more.begin(), more.end());
+	model.insert(more.begin(), more.end());
+	while (!model.empty()) {
+		REQUIRE(h.top_max() == *model.rbegin());
+		h.pop_max();
+		model.erase(std::prev(model.end()));
+	}
+	REQUIRE(h.empty());
+}
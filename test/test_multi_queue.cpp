@@ -0,0 +1,106 @@
+/**
+ * @file test_multi_queue.cpp
+ * @brief Unit tests for kj::MultiQueue<T, Comp, Heap> and kj::rank_errors.
+ *
+ * Verifies exact ordering with a single queue, that concurrent push/pop loses
+ * and duplicates nothing, handle statistics, and the rank-error metric.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/multi_queue.hpp>
+#include <kj/skew_heap.hpp>
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+/**
+ * @test Verifies the rank-error metric on small sequences.
+ */
+TEST_CASE("kj::rank_errors", "[multi_queue][metrics]") {
+	const std::vector<int> exact = { 1, 2, 2, 3 };
+	auto r = kj::rank_errors<int>(exact);
+	REQUIRE(r.max == 0);
+	REQUIRE(r.mean == 0.0);
+
+	const std::vector<int> relaxed = { 1, 3, 2, 4 };   // 3 popped while 2 was queued
+	r = kj::rank_errors<int>(relaxed);
+	REQUIRE(r.max == 1);
+	REQUIRE(r.mean == 0.25);
+
+	const std::vector<int> maxfirst = { 3, 1, 2 };
+	r = kj::rank_errors<int>(maxfirst, std::greater<int>{});
+	REQUIRE(r.max == 1);   // 1 popped while 2 was queued
+}
+
+/**
+ * @test Verifies that a single internal queue behaves like an exact priority queue.
+ */
+TEST_CASE("kj::MultiQueue single queue is exact", "[multi_queue][basic]") {
+	kj::MultiQueue<int, std::less<int>, kj::SkewHeap<int>> q(1, 1);
+	REQUIRE(q.queues() == 1);
+	REQUIRE(q.empty());
+	std::vector<int> pops;
+	{
+		auto h = q.handle(1);
+		for (int x : {5, 3, 9, 1, 7}) h.push(x);
+		REQUIRE(q.size() == 5);
+		int v = 0;
+		while (h.try_pop(v)) pops.push_back(v);
+		REQUIRE_FALSE(h.try_pop(v));
+		REQUIRE(h.stats().pushes == 5);
+	}
+	REQUIRE(pops == std::vector<int>({ 1, 3, 5, 7, 9 }));
+	const auto s = q.stats();
+	REQUIRE(s.pushes == 5);
+	REQUIRE(s.pops == 5);
+	REQUIRE(s.empty_pops == 2);
+}
+
+/**
+ * @test Verifies that concurrent pushes and pops neither lose nor duplicate elements.
+ */
+TEST_CASE("kj::MultiQueue concurrent push/pop", "[multi_queue][threads]") {
+	constexpr unsigned threads = 4;
+	constexpr std::uint32_t per_thread = 5000;
+	kj::MultiQueue<std::uint32_t> q(threads, 2);
+	REQUIRE(q.queues() == 8);
+
+	std::vector<std::vector<std::uint32_t>> got(threads);
+	std::vector<std::thread> pool;
+	for (unsigned t = 0; t < threads; ++t) {
+		pool.emplace_back([&, t] {
+			auto h = q.handle(t + 1);
+			for (std::uint32_t i = 0; i < per_thread; ++i) {
+				h.push(t * per_thread + i);
+				if (i % 2) { std::uint32_t v; if (h.try_pop(v)) got[t].push_back(v); }
+			}
+			for (std::uint32_t v; h.try_pop(v); ) got[t].push_back(v);
+		});
+	}
+	for (auto& th : pool) th.join();
+
+	std::vector<std::uint32_t> all;
+	for (auto& g : got) all.insert(all.end(), g.begin(), g.end());
+	std::sort(all.begin(), all.end());
+	REQUIRE(all.size() == threads * per_thread);
+	for (std::uint32_t i = 0; i < all.size(); ++i) REQUIRE(all[i] == i);
+	REQUIRE(q.empty());
+	REQUIRE(q.stats().pushes == threads * per_thread);
+	REQUIRE(q.stats().pops == threads * per_thread);
+}
+
+/**
+ * @test Verifies that a sequential drain stays close to priority order.
+ */
+TEST_CASE("kj::MultiQueue rank error is bounded", "[multi_queue][metrics]") {
+	kj::MultiQueue<std::uint64_t> q(4, 2);
+	auto h = q.handle(42);
+	for (std::uint64_t i = 0; i < 20000; ++i) h.push((i * 7919) % 20000);
+	std::vector<std::uint64_t> pops;
+	for (std::uint64_t v; h.try_pop(v); ) pops.push_back(v);
+	REQUIRE(pops.size() == 20000);
+	const auto r = kj::rank_errors<std::uint64_t>(pops);
+	REQUIRE(r.mean < 16.0);   // expected O(queues) = O(8)
+}
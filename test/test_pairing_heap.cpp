@@ -0,0 +1,128 @@
+/**
+ * @file test_pairing_heap.cpp
+ * @brief Unit tests for kj::PairingHeap<T, Comp>.
+ *
+ * Verifies ordering, comparator customization, merge, and handle-based
+ * decrease_key / erase against a std::multiset model.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/pairing_heap.hpp>
+#include <vector>
+#include <set>
+#include <string>
+#include <functional>
+
+/**
+ * @test Verifies min-heap and max-heap ordering with push/pop.
+ */
+TEST_CASE("kj::PairingHeap ordering", "[pairing_heap][basic]") {
+	kj::PairingHeap<int> h;
+	for (int x : {5, 3, 7, 2, 9, 1, 8}) h.push(x);
+	std::vector<int> got;
+	while (!h.empty()) { got.push_back(h.top()); h.pop(); }
+	REQUIRE(got == std::vector<int>({ 1, 2, 3, 5, 7, 8, 9 }));
+
+	kj::PairingHeap<std::string, std::greater<std::string>> m;
+	m.emplace("b"); m.emplace("c"); m.emplace("a");
+	REQUIRE(m.size() == 3);
+	REQUIRE(m.top() == "c");
+}
+
+/**
+ * @test Verifies merge on a shared pool and across pools.
+ */
+TEST_CASE("kj::PairingHeap merge", "[pairing_heap][merge]") {
+	using H = kj::PairingHeap<int>;
+	H::pool_type pool;
+	H a(pool), b(pool), c;
+	for (int x : {5, 1, 9}) a.push(x);
+	auto h6 = b.push(6);
+	b.push(2);
+	for (int x : {3, 4}) c.push(x);
+
+	a.merge(b);                  // same pool: O(1) link, handles stay valid
+	REQUIRE(b.empty());
+	a.decrease_key(h6, 0);
+	a.merge(c);                  // different pools: elements moved over
+	REQUIRE(c.empty());
+
+	std::vector<int> got;
+	while (!a.empty()) { got.push_back(a.top()); a.pop(); }
+	REQUIRE(got == std::vector<int>({ 0, 1, 2, 3, 4, 5, 9 }));
+}
+
+/**
+ * @test Verifies a random mix of push/pop/decrease_key/erase against a multiset model.
+ */
+TEST_CASE("kj::PairingHeap random operations", "[pairing_heap][random]") {
+	using H = kj::PairingHeap<int>;
+	H h;
+	std::multiset<int> model;
+	std::vector<H::handle> live;
+
+	unsigned s = 31337;
+	auto rnd = [&](int m) { s = s * 1103515245u + 12345u; return static_cast<int>((s >> 8) % m); };
+
+	for (int step = 0; step < 20000; ++step) {
+		const int op = rnd(10);
+		if (op < 4 || live.empty()) {
+			const int v = rnd(100000);
+			live.push_back(h.push(v));
+			model.insert(v);
+		}
+		else if (op < 6) {
+			const int i = rnd(static_cast<int>(live.size()));
+			const int old = h.value(live[i]);
+			const int v = old - rnd(1000);
+			h.decrease_key(live[i], v);
+			model.erase(model.find(old));
+			model.insert(v);
+		}
+		else if (op < 8) {
+			const int i = rnd(static_cast<int>(live.size()));
+			model.erase(model.find(h.value(live[i])));
+			h.erase(live[i]);
+			live[i] = live.back(); live.pop_back();
+		}
+		else {
+			const auto top = h.top_handle();
+			REQUIRE(h.top() == *model.begin());
+			model.erase(model.begin());
+			for (auto& x : live) if (x == top) { x = live.back(); live.pop_back(); break; }
+			h.pop();
+		}
+		REQUIRE(h.size() == model.size());
+		if (!model.empty()) REQUIRE(h.top() == *model.begin());
+	}
+}
+
+/**
+ * @test Verifies that move-assigning into a heap keeps its own pool alive for heaps bound to it.
+ */
+TEST_CASE("kj::PairingHeap move assignment keeps a shared own pool", "[pairing_heap][move]") {
+	using H = kj::PairingHeap<std::string>;
+	H src;
+	src.push("x");
+	{
+		H a;
+		a.push("a");
+		H bound(a.pool());                       // shares a's own pool
+		auto h = bound.push("s");
+		for (const char* s : { "q", "r" }) bound.push(s);
+
+		a = std::move(src);                      // a's old pool passes to src
+		REQUIRE(a.size() == 1);
+		REQUIRE(a.top() == "x");
+		REQUIRE(src.empty());
+
+		bound.push("o");
+		bound.decrease_key(h, "p");
+		std::string got;
+		while (!bound.empty()) { got += bound.top(); bound.pop(); }
+		REQUIRE(got == "opqr");
+		REQUIRE(src.pool().live() == 0);
+	}
+	src.push("y");
+	REQUIRE(src.top() == "y");
+}
@@ -0,0 +1,96 @@
+/**
+ * @file test_persistent_heap.cpp
+ * @brief Unit tests for kj::PersistentLeftistHeap<T, Comp>.
+ *
+ * Verifies that old versions stay valid after push/pop/merge, that new versions
+ * allocate only O(log n) nodes, and k-smallest enumeration.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/persistent_heap.hpp>
+#include <vector>
+#include <string>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+namespace {
+	template <class H>
+	auto contents(const H& h) {
+		std::vector<std::decay_t<decltype(h.top())>> out;
+		h.smallest(h.size(), std::back_inserter(out));
+		return out;
+	}
+}
+
+/**
+ * @test Verifies that every version keeps its own contents.
+ */
+TEST_CASE("kj::PersistentLeftistHeap versions", "[persistent_heap][basic]") {
+	using H = kj::PersistentLeftistHeap<int>;
+	H::arena_type arena;
+	std::vector<H> versions{ H(arena) };
+	std::vector<int> keys;
+	for (int i = 0; i < 200; ++i) {
+		const int x = (i * 37) % 101;
+		versions.push_back(versions.back().push(x));
+		keys.push_back(x);
+	}
+	for (std::size_t v = 0; v < versions.size(); ++v) {
+		std::vector<int> want(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(v));
+		std::sort(want.begin(), want.end());
+		REQUIRE(versions[v].size() == v);
+		REQUIRE(contents(versions[v]) == want);
+	}
+
+	const H full = versions.back();
+	const H popped = full.pop().pop();
+	REQUIRE(full.size() == 200);
+	REQUIRE(full.top() == 0);
+	REQUIRE(popped.size() == 198);
+	const std::vector<int> all = contents(full);
+	REQUIRE(contents(popped) == std::vector<int>(all.begin() + 2, all.end()));
+
+	const H both = versions[10].merge(popped);
+	REQUIRE(both.size() == 208);
+	REQUIRE(contents(popped).size() == 198);          // inputs unchanged
+	REQUIRE(contents(versions[10]).size() == 10);
+	REQUIRE(H().merge(both).size() == 208);
+}
+
+/**
+ * @test Verifies structural sharing: each push path-copies only O(log n) nodes.
+ */
+TEST_CASE("kj::PersistentLeftistHeap structural sharing", "[persistent_heap][sharing]") {
+	using H = kj::PersistentLeftistHeap<int>;
+	H::arena_type arena;
+	H h(arena);
+	for (int i = 0; i < 4096; ++i) h = h.push(i * 7919 % 4096);
+	const std::size_t before = arena.size();
+	const H a = h.push(-1), b = h.push(5000), c = a.pop();
+	REQUIRE(arena.size() - before <= 3 * (2 * 13 + 1));   // 2 * log2(4097) + new leaf each
+	REQUIRE(a.top() == -1);
+	REQUIRE(b.top() == 0);
+	REQUIRE(c.top() == 0);
+	REQUIRE(h.size() == 4096);
+
+	arena.clear();
+	REQUIRE(arena.size() == 0);
+}
+
+/**
+ * @test Verifies k-smallest enumeration and non-trivial keys with a max comparator.
+ */
+TEST_CASE("kj::PersistentLeftistHeap smallest(k)", "[persistent_heap][enumerate]") {
+	using H = kj::PersistentLeftistHeap<std::string, std::greater<std::string>>;
+	H::arena_type arena;
+	H h(arena);
+	for (const char* s : { "m", "c", "x", "a", "q", "z" }) h = h.push(s);
+	std::vector<std::string> top3;
+	h.smallest(3, std::back_inserter(top3));
+	REQUIRE(top3 == std::vector<std::string>({ "z", "x", "q" }));
+	std::vector<std::string> all;
+	h.smallest(100, std::back_inserter(all));
+	REQUIRE(all.size() == 6);
+	REQUIRE(h.pop().top() == "x");
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_radix_heap.cpp
+ * @brief Unit tests for kj::RadixHeap<Key, Value>.
+ *
+ * Verifies monotone extraction order against a std::multiset model, full-width
+ * keys, non-trivial payloads, and bucket reuse after clear.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/radix_heap.hpp>
+#include <set>
+#include <limits>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @test Verifies basic ordering and payload access.
+ */
+TEST_CASE("kj::RadixHeap ordering", "[radix_heap][basic]") {
+	kj::RadixHeap<std::uint32_t, std::string> h;
+	REQUIRE(h.empty());
+	h.push(5, "five");
+	h.push(3, "three");
+	h.emplace(9, 3, 'x');
+	h.push(3, "three'");
+	REQUIRE(h.size() == 4);
+
+	REQUIRE(h.top().first == 3);
+	h.pop();
+	REQUIRE(h.top().first == 3);
+	h.pop();
+	REQUIRE(h.last_key() == 3);
+	h.push(4, "four");   // monotone: >= last extracted
+	REQUIRE(h.top().second == "four");
+	h.pop();
+	REQUIRE(h.top().second == "five");
+	h.pop();
+	REQUIRE(h.top().second == "xxx");
+	h.pop();
+	REQUIRE(h.empty());
+}
+
+/**
+ * @test Verifies a random monotone workload against a model, including extreme keys.
+ */
+TEST_CASE("kj::RadixHeap monotone workload", "[radix_heap][model]") {
+	kj::RadixHeap<std::uint64_t, int> h;
+	std::multiset<std::uint64_t> model;
+	std::mt19937_64 rng(11);
+	std::uint64_t last = 0;
+
+	for (int step = 0; step < 20000; ++step) {
+		if (model.empty() || rng() % 3 != 0) {
+			const std::uint64_t span = (rng() % 4 == 0) ? (std::uint64_t{ 1 } << (rng() % 62)) : 100;
+			const std::uint64_t k = last + rng() % span;
+			h.push(k, step);
+			model.insert(k);
+		}
+		else {
+			REQUIRE(h.top().first == *model.begin());
+			last = *model.begin();
+			model.erase(model.begin());
+			h.pop();
+		}
+		REQUIRE(h.size() == model.size());
+	}
+
+	h.clear();
+	REQUIRE(h.empty());
+	REQUIRE(h.last_key() == 0);
+	const auto big = std::numeric_limits<std::uint64_t>::max();
+	h.push(big, 1);
+	h.push(0, 2);
+	h.push(big - 1, 3);
+	REQUIRE(h.top().second == 2); h.pop();
+	REQUIRE(h.top().second == 3); h.pop();
+	REQUIRE(h.top().second == 1); h.pop();
+	REQUIRE(h.empty());
+}
+
+/**
+ * @test Verifies narrow keys and move construction.
+ */
+TEST_CASE("kj::RadixHeap narrow keys and move", "[radix_heap][types]") {
+	kj::RadixHeap<std::uint8_t, int> h;
+	for (int k = 255; k >= 0; --k) h.push(static_cast<std::uint8_t>(k), k);
+	auto m = std::move(h);
+	for (int k = 0; k < 256; ++k) {
+		REQUIRE(m.top().second == k);
+		m.pop();
+	}
+	REQUIRE(m.empty());
+}
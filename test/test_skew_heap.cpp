@@ -8,10 +8,12 @@
 
 #include <catch2/catch_all.hpp>
 #include <kj/skew_heap.hpp>
+#include <kj/buffer.hpp>
 #include <vector>
 #include <algorithm>
 #include <utility>
 #include <string>
+#include <stdexcept>
 
  /**
   * @test Verifies min-heap ordering with push/pop.
@@ -150,3 +152,466 @@ TEST_CASE("kj::SkewHeapArena behaves like SkewHeap and supports reserve/release"
 	// Heap is empty now; we can release pool memory.
 	h.release_all_to_pool();
 }
+
+/**
+ * @test Verifies the iterative merge builds exactly the tree of the recursive one.
+ */
+TEST_CASE("kj::detail::skew_merge matches recursive merge", "[skew_heap][merge][iterative]") {
+	struct Node { int key; Node* left; Node* right; };
+	const int n = 500;
+	std::vector<Node> a(n), b(n);
+	std::less<int> cmp;
+
+	unsigned s = 99;
+	std::vector<int> keys(n);
+	for (auto& k : keys) { s = s * 1103515245u + 12345u; k = static_cast<int>((s >> 8) % 1000); }
+
+	Node* ra = nullptr;
+	Node* rb = nullptr;
+	for (int i = 0; i < n; ++i) {
+		a[i] = Node{ keys[i], nullptr, nullptr };
+		b[i] = Node{ keys[i], nullptr, nullptr };
+		ra = kj::detail::skew_merge(ra, &a[i], cmp);
+		rb = kj::detail::skew_merge_recursive(rb, &b[i], cmp);
+		if (i % 7 == 6) {   // interleave some pops
+			ra = kj::detail::skew_merge(ra->left, ra->right, cmp);
+			rb = kj::detail::skew_merge_recursive(rb->left, rb->right, cmp);
+		}
+	}
+
+	// Same shape: compare node indices position by position
+	auto idx = [](Node* p, const std::vector<Node>& v) { return p ? static_cast<long>(p - v.data()) : -1L; };
+	REQUIRE(idx(ra, a) == idx(rb, b));
+	for (int i = 0; i < n; ++i) {
+		REQUIRE(idx(a[i].left, a) == idx(b[i].left, b));
+		REQUIRE(idx(a[i].right, a) == idx(b[i].right, b));
+	}
+}
+
+/**
+ * @test Verifies clear/destruction of a degenerate (left-chain) heap does not recurse.
+ */
+TEST_CASE("kj::SkewHeap clears degenerate heaps without recursion", "[skew_heap][clear]") {
+	const int n = 1000000;   // descending pushes build a left chain of depth n
+
+	{
+		kj::SkewHeap<int> h;
+		for (int i = n; i > 0; --i) h.push(i);
+		REQUIRE(h.size() == static_cast<std::size_t>(n));
+		h.clear();
+		REQUIRE(h.empty());
+		for (int i = n; i > 0; --i) h.push(i);
+	} // destructor takes the same path
+
+	{
+		kj::SkewHeapArena<std::string> h;
+		for (int i = 100000; i > 0; --i) h.push(std::to_string(i));
+		h.clear();
+		REQUIRE(h.empty());
+		h.release_all_to_pool();
+	}
+}
+
+/**
+ * @test Verifies O(1) pool recycling for trivially destructible keys and reuse afterwards.
+ */
+TEST_CASE("kj::SkewHeapArena clear recycles the pool", "[skew_heap][pool][clear]") {
+	kj::SkewHeapArena<int> h;
+	for (int i = 0; i < 10000; ++i) h.push(10000 - i);
+	h.clear();
+	REQUIRE(h.empty());
+	REQUIRE(h.size() == 0);
+
+	for (int x : {5, 3, 7}) h.push(x);
+	std::vector<int> got;
+	while (!h.empty()) { got.push_back(h.top()); h.pop(); }
+	REQUIRE(got == std::vector<int>({ 3, 5, 7 }));
+	h.release_all_to_pool();
+}
+
+/**
+ * @test Verifies many arena heaps on one shared pool: merge, move and swap.
+ */
+TEST_CASE("kj::SkewHeapArena shared pool, move and swap", "[skew_heap][pool][shared]") {
+	using H = kj::SkewHeapArena<int>;
+	H::pool_type pool;
+
+	{
+		std::vector<H> heaps;
+		for (int i = 0; i < 100; ++i) {
+			heaps.emplace_back(pool);            // vector growth moves heaps around
+			heaps.back().push(100 - i);
+			heaps.back().push(200 + i);
+		}
+		REQUIRE(pool.live() == 200);
+
+		for (int i = 1; i < 100; ++i) heaps[0].merge(heaps[i]);
+		REQUIRE(heaps[0].size() == 200);
+		REQUIRE(heaps[1].empty());
+		REQUIRE(pool.live() == 200);             // no node was copied
+
+		H moved = std::move(heaps[0]);
+		REQUIRE(heaps[0].empty());
+		REQUIRE(moved.top() == 1);
+
+		H other(pool);
+		other.push(-5);
+		swap(moved, other);
+		REQUIRE(moved.size() == 1);
+		REQUIRE(other.size() == 200);
+
+		int prev = other.top();
+		other.pop();
+		while (!other.empty()) { REQUIRE(prev <= other.top()); prev = other.top(); other.pop(); }
+		REQUIRE(pool.live() == 1);
+	}
+	REQUIRE(pool.live() == 0);
+}
+
+/**
+ * @test Verifies merge between heaps on different pools and moving an own-pool heap.
+ */
+TEST_CASE("kj::SkewHeapArena cross-pool merge and own-pool move", "[skew_heap][pool][merge]") {
+	kj::SkewHeapArena<std::string> a, b;
+	for (const char* s : { "d", "a", "f" }) a.push(s);
+	for (const char* s : { "c", "b", "e" }) b.push(s);
+
+	a.merge(b);                                  // different pools: elements are moved over
+	REQUIRE(b.empty());
+	REQUIRE(a.size() == 6);
+
+	kj::SkewHeapArena<std::string> c(std::move(a));
+	REQUIRE(a.empty());
+	std::string got;
+	while (!c.empty()) { got += c.top(); c.pop(); }
+	REQUIRE(got == "abcdef");
+
+	// Moved-from heap is usable again
+	a.push("z");
+	REQUIRE(a.top() == "z");
+}
+
+/**
+ * @test Verifies that move-assigning into a heap keeps its own pool alive for heaps bound to it.
+ */
+TEST_CASE("kj::SkewHeapArena move assignment keeps a shared own pool", "[skew_heap][pool][move]") {
+	using H = kj::SkewHeapArena<std::string>;
+	H src;
+	src.push("x");
+	{
+		H a;
+		a.push("a");
+		H bound(a.pool());                       // shares a's own pool
+		for (const char* s : { "q", "p", "r" }) bound.push(s);
+
+		a = std::move(src);                      // a's old pool passes to src
+		REQUIRE(a.size() == 1);
+		REQUIRE(a.top() == "x");
+		REQUIRE(src.empty());
+
+		bound.push("o");
+		std::string got;
+		while (!bound.empty()) { got += bound.top(); bound.pop(); }
+		REQUIRE(got == "opqr");
+		REQUIRE(src.pool().live() == 0);
+	}
+	src.push("y");
+	REQUIRE(src.top() == "y");
+}
+
+/**
+ * @test Verifies range construction and push_range for plain and arena heaps.
+ */
+TEST_CASE("kj::SkewHeap range construction and push_range", "[skew_heap][bulk]") {
+	std::vector<int> v;
+	unsigned s = 5;
+	for (int i = 0; i < 10000; ++i) { s = s * 1103515245u + 12345u; v.push_back(static_cast<int>((s >> 8) % 5000)); }
+	std::vector<int> sorted = v;
+	std::sort(sorted.begin(), sorted.end());
+
+	kj::SkewHeap<int> h(v.begin(), v.end());
+	REQUIRE(h.size() == v.size());
+	std::vector<int> got;
+	while (!h.empty()) { got.push_back(h.top()); h.pop(); }
+	REQUIRE(got == sorted);
+
+	kj::SkewHeapArena<int, std::greater<int>> a;
+	a.push(-1);
+	a.push_range(v.begin(), v.begin() + 5000);
+	a.push_range(v.begin() + 5000, v.end());
+	REQUIRE(a.size() == v.size() + 1);
+	got.clear();
+	while (!a.empty()) { got.push_back(a.top()); a.pop(); }
+	std::vector<int> expect = sorted;
+	expect.insert(expect.begin(), -1);
+	std::reverse(expect.begin(), expect.end());
+	REQUIRE(got == expect);
+
+	const std::vector<std::string> words = { "pear", "apple", "fig" };
+	kj::SkewHeapArena<std::string> w(words.begin(), words.end());
+	REQUIRE(w.top() == "apple");
+}
+
+namespace {
+	// Copy throws once a global budget is used up (for push_range unwinding).
+	struct Fragile {
+		static inline int budget = 0;
+		int v = 0;
+		explicit Fragile(int x) : v(x) {}
+		Fragile(const Fragile& o) : v(o.v) { if (budget-- == 0) throw std::runtime_error("copy"); }
+		Fragile(Fragile&&) noexcept = default;
+		Fragile& operator=(const Fragile&) = default;
+		Fragile& operator=(Fragile&&) noexcept = default;
+		~Fragile() = default;
+		bool operator<(const Fragile& o) const noexcept { return v < o.v; }
+	};
+
+	template <class Heap>
+	void check_push_range_throws(Heap& h) {
+		std::vector<Fragile> src;
+		for (int i = 0; i < 100; ++i) src.emplace_back(100 - i);
+		h.push(Fragile(1000));
+		Fragile::budget = 40;
+		bool threw = false;
+		try { h.push_range(src.begin(), src.end()); }
+		catch (const std::runtime_error&) { threw = true; }
+		REQUIRE(threw);
+		REQUIRE(h.size() == 1);
+		REQUIRE(h.top().v == 1000);
+		Fragile::budget = -1;
+		h.push_range(src.begin(), src.end());
+		REQUIRE(h.size() == 101);
+		REQUIRE(h.top().v == 1);
+	}
+}
+
+/**
+ * @test Verifies that a throwing copy in push_range leaves the heap and its pool unchanged.
+ */
+TEST_CASE("kj::SkewHeap push_range is exception safe", "[skew_heap][bulk]") {
+	kj::SkewHeap<Fragile> plain;
+	check_push_range_throws(plain);
+
+	kj::SkewHeapArena<Fragile> arena;
+	arena.reserve_nodes(1);
+	check_push_range_throws(arena);
+	arena.clear();
+	REQUIRE(arena.pool().live() == 0);
+}
+
+namespace {
+	// Move assignment throws once a global budget is used up (for pop_k unwinding).
+	struct Brittle {
+		static inline int budget = -1;
+		int v = 0;
+		Brittle() = default;
+		explicit Brittle(int x) : v(x) {}
+		Brittle(Brittle&&) noexcept = default;
+		Brittle& operator=(Brittle&& o) {
+			if (budget-- == 0) throw std::runtime_error("move");
+			v = o.v;
+			return *this;
+		}
+		bool operator<(const Brittle& o) const noexcept { return v < o.v; }
+	};
+
+	// Comparison throws once a global budget is used up (for the sort in drain_sorted).
+	struct BrittleLess {
+		static inline int budget = -1;
+		bool operator()(int a, int b) const {
+			if (budget-- == 0) throw std::runtime_error("less");
+			return a < b;
+		}
+	};
+
+	template <class Heap>
+	void check_pop_all_throws(Heap& h) {
+		for (int i = 0; i < 200; ++i) h.push(Brittle((i * 37) % 200));
+		std::vector<Brittle> out(h.size());
+		Brittle::budget = 60;
+		bool threw = false;
+		try { h.pop_k(out.size(), out); }
+		catch (const std::runtime_error&) { threw = true; }
+		Brittle::budget = -1;
+		REQUIRE(threw);
+		REQUIRE(h.empty());
+		REQUIRE(h.size() == 0);
+		h.push(Brittle(7));
+		REQUIRE(h.top().v == 7);
+	}
+}
+
+/**
+ * @test Verifies that a throwing move or comparison while taking the whole heap leaves it
+ * empty and frees every node exactly once.
+ */
+TEST_CASE("kj::SkewHeap full extraction is exception safe", "[skew_heap][bulk]") {
+	kj::SkewHeap<Brittle> plain;
+	check_pop_all_throws(plain);
+
+	kj::SkewHeapArena<Brittle> arena;             // sole owner of its pool: bulk reset
+	check_pop_all_throws(arena);
+	arena.clear();
+	REQUIRE(arena.pool().live() == 0);
+
+	kj::SkewHeapArena<Brittle> owner;
+	owner.push(Brittle(-1));
+	kj::SkewHeapArena<Brittle> shared(owner.pool()); // pool shared: nodes freed one by one
+	check_pop_all_throws(shared);
+	shared.clear();
+	REQUIRE(owner.pool().live() == 1);
+
+	kj::SkewHeapArena<int, BrittleLess> ints;
+	for (int i = 0; i < 200; ++i) ints.push((i * 37) % 200);
+	kj::Buffer<int> buf(0);
+	BrittleLess::budget = 10;
+	bool threw = false;
+	try { ints.drain_sorted(buf); }
+	catch (const std::runtime_error&) { threw = true; }
+	BrittleLess::budget = -1;
+	REQUIRE(threw);
+	REQUIRE(ints.empty());
+	REQUIRE(ints.pool().live() == 0);
+	ints.push(3);
+	REQUIRE(ints.top() == 3);
+}
+
+namespace {
+	// Random push/pop/add_all/merge workload checked against two sorted-vector models.
+	template <class Heap, class... PoolArgs>
+	void check_lazy_model(PoolArgs&... pool) {
+		Heap a(pool...), b(pool...);
+		std::vector<long long> ma, mb;
+		unsigned s = 17;
+		auto rnd = [&s] { s = s * 1103515245u + 12345u; return (s >> 8) % 1000; };
+
+		for (int step = 0; step < 4000; ++step) {
+			const unsigned op = rnd() % 6;
+			if (op <= 1) { const long long x = rnd(); a.push(x); ma.push_back(x); }
+			else if (op == 2) { const long long x = rnd(); b.push(x); mb.push_back(x); }
+			else if (op == 3) {
+				const long long d = static_cast<long long>(rnd()) - 500;
+				a.add_all(d); for (auto& x : ma) x += d;
+				b.add_all(-d); for (auto& x : mb) x -= d;
+			}
+			else if (op == 4 && !ma.empty()) {
+				auto it = std::min_element(ma.begin(), ma.end());
+				REQUIRE(a.top() == *it);
+				ma.erase(it);
+				a.pop();
+			}
+			else if (op == 5 && rnd() % 8 == 0) {
+				a.merge(b);
+				ma.insert(ma.end(), mb.begin(), mb.end());
+				mb.clear();
+			}
+			REQUIRE(a.size() == ma.size());
+			if (!ma.empty()) REQUIRE(a.top() == *std::min_element(ma.begin(), ma.end()));
+		}
+		a.merge(b);
+		ma.insert(ma.end(), mb.begin(), mb.end());
+		std::sort(ma.begin(), ma.end());
+		std::vector<long long> got;
+		while (!a.empty()) { got.push_back(a.top()); a.pop(); }
+		REQUIRE(got == ma);
+	}
+}
+
+/**
+ * @test Verifies O(1) add_all with lazy tags across merge and pop, pooled and unpooled.
+ */
+TEST_CASE("kj::LazySkewHeap add_all", "[skew_heap][lazy]") {
+	kj::LazySkewHeap<int> h;
+	h.add_all(5);                       // no-op on an empty heap
+	for (int x : {4, 1, 3}) h.push(x);
+	h.add_all(10);
+	h.push(12);
+	kj::LazySkewHeap<int> g;
+	for (int x : {2, 20}) g.push(x);
+	g.add_all(-1);
+	h.merge(g);
+	std::vector<int> got;
+	while (!h.empty()) { got.push_back(h.top()); h.pop(); }
+	REQUIRE(got == std::vector<int>({ 1, 11, 12, 13, 14, 19 }));
+
+	kj::LazySkewHeapArena<double, std::greater<double>> m;
+	m.push(1.5); m.push(-2.0);
+	m.add_all(0.5);
+	REQUIRE(m.top() == 2.0);
+
+	check_lazy_model<kj::LazySkewHeap<long long>>();
+	check_lazy_model<kj::LazySkewHeapArena<long long>>();
+	kj::LazySkewHeapArena<long long>::pool_type pool;
+	check_lazy_model<kj::LazySkewHeapArena<long long>>(pool);
+}
+
+/**
+ * @test Verifies pop_k and drain_sorted for pooled, shared-pool and unpooled heaps.
+ */
+TEST_CASE("kj::SkewHeap pop_k and drain_sorted", "[skew_heap][bulk]") {
+	std::vector<int> v;
+	for (int i = 0; i < 1000; ++i) v.push_back((i * 7919) % 1000);
+
+	kj::SkewHeap<int> h(v.begin(), v.end());
+	std::vector<int> out(10, -1);
+	REQUIRE(h.pop_k(3, out) == 3);
+	REQUIRE(out[0] == 0); REQUIRE(out[1] == 1); REQUIRE(out[2] == 2); REQUIRE(out[3] == -1);
+	REQUIRE(h.pop_k(100, out) == 10);    // bounded by the span
+	REQUIRE(out[9] == 12);
+	REQUIRE(h.size() == 987);
+
+	kj::Buffer<int> buf(0);
+	REQUIRE(h.drain_sorted(buf) == 987);
+	REQUIRE(h.empty());
+	REQUIRE(buf.size() >= 987);
+	for (int i = 0; i < 987; ++i) REQUIRE(buf[static_cast<std::size_t>(i)] == i + 13);
+
+	// own pool: the whole drain recycles the pool at once
+	kj::SkewHeapArena<int, std::greater<int>> a(v.begin(), v.end());
+	REQUIRE(a.drain_sorted(buf) == 1000);
+	REQUIRE(buf[0] == 999);
+	REQUIRE(a.pool().live() == 0);
+	a.push(5);
+	REQUIRE(a.top() == 5);
+
+	// shared pool: other heap's nodes stay intact
+	kj::SkewHeapArena<int>::pool_type pool;
+	kj::SkewHeapArena<int> x(pool), y(pool);
+	for (int i = 0; i < 50; ++i) { x.push(i); y.push(100 + i); }
+	REQUIRE(x.drain_sorted(buf) == 50);
+	REQUIRE(pool.live() == 50);
+	REQUIRE(y.top() == 100);
+
+	// non-trivial keys are moved out
+	kj::SkewHeapArena<std::string> w;
+	for (const char* s : { "pear", "apple", "fig" }) w.push(s);
+	std::vector<std::string> words(3);
+	REQUIRE(w.pop_k(3, words) == 3);
+	REQUIRE(words == std::vector<std::string>({ "apple", "fig", "pear" }));
+	REQUIRE(w.empty());
+
+	kj::LazySkewHeapArena<int> lz;
+	for (int i = 0; i < 5; ++i) lz.push(i);
+	lz.add_all(10);
+	REQUIRE(lz.pop_k(5, out) == 5);
+	REQUIRE(out[0] == 10); REQUIRE(out[4] == 14);
+
+	// tags pending at many depths survive the rotation walk of a full drain
+	kj::LazySkewHeapArena<int> deep;
+	std::vector<int> model;
+	for (int i = 0; i < 300; ++i) {
+		const int key = (i * 37) % 101;
+		deep.push(key);
+		model.push_back(key);
+		if (i % 7 == 0) {
+			deep.add_all(3);
+			for (int& m : model) m += 3;
+		}
+	}
+	std::sort(model.begin(), model.end());
+	REQUIRE(deep.pop_k(20, out) == 10);
+	REQUIRE(deep.pool().live() == 290);     // partial extraction returned its nodes
+	REQUIRE(deep.drain_sorted(buf) == 290);
+	for (std::size_t i = 0; i < 10; ++i) REQUIRE(out[i] == model[i]);
+	for (std::size_t i = 0; i < 290; ++i) REQUIRE(buf[i] == model[i + 10]);
+}
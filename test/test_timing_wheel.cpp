@@ -0,0 +1,178 @@
+/**
+ * @file test_timing_wheel.cpp
+ * @brief Unit tests for kj::TimingWheel.
+ *
+ * Verifies expiry order against a model over long random delays (cascades),
+ * cancellation with stale handles, slab reuse, and the clock-based API.
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/timing_wheel.hpp>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @test Verifies basic firing and batching.
+ */
+TEST_CASE("kj::TimingWheel basic", "[timing_wheel]") {
+	kj::TimingWheel<int> w;
+	std::vector<int> out;
+	w.schedule_in_ticks(5, 1);
+	w.schedule_in_ticks(3, 2);
+	w.schedule_in_ticks(5, 3);
+	w.schedule_in_ticks(0, 4);
+	REQUIRE(w.size() == 4);
+	REQUIRE(w.next_event_tick() == 0);
+
+	REQUIRE(w.advance_ticks(0, out) == 1);
+	REQUIRE(out == std::vector<int>{ 4 });
+	REQUIRE(w.advance_ticks(4, out) == 1);
+	REQUIRE(w.now_tick() == 4);
+	REQUIRE(w.advance_ticks(1, out) == 2);
+	REQUIRE(out.size() == 4);
+	REQUIRE(out[1] == 2);
+	REQUIRE(out[2] + out[3] == 4);
+	REQUIRE(w.empty());
+	REQUIRE(w.next_event_tick() == UINT64_MAX);
+}
+
+/**
+ * @test Verifies expiry ticks against a model, with delays reaching the upper levels and cancels.
+ */
+TEST_CASE("kj::TimingWheel model", "[timing_wheel]") {
+	std::mt19937_64 rng(7);
+	kj::TimingWheel<std::uint64_t> w;
+	std::vector<std::uint64_t> expiry;        // id -> expiry tick
+	std::vector<kj::TimerHandle> handles;     // id -> handle
+	std::multimap<std::uint64_t, std::uint64_t> model;
+	std::vector<std::uint64_t> out;
+
+	for (int round = 0; round < 400; ++round) {
+		for (int i = 0; i < 50; ++i) {
+			const std::uint64_t d = rng() & ((std::uint64_t{ 1 } << (rng() % 40)) - 1);
+			const std::uint64_t id = expiry.size();
+			handles.push_back(w.schedule_in_ticks(d, id));
+			expiry.push_back(w.now_tick() + d);
+			model.emplace(expiry.back(), id);
+		}
+		for (int i = 0; i < 10; ++i) {
+			const std::uint64_t id = rng() % handles.size();
+			const bool was = w.pending(handles[id]);
+			REQUIRE(w.cancel(handles[id]) == was);
+			REQUIRE_FALSE(w.pending(handles[id]));
+			if (was) {
+				auto [b, e] = model.equal_range(expiry[id]);
+				while (b->second != id) ++b;
+				model.erase(b);
+			}
+		}
+		const std::uint64_t step = rng() & ((std::uint64_t{ 1 } << (rng() % 36)) - 1);
+		const std::uint64_t target = w.now_tick() + step;
+		out.clear();
+		const std::size_t fired = w.advance_ticks(step, out);
+		REQUIRE(fired == out.size());
+		REQUIRE(w.now_tick() == target);
+
+		std::vector<std::uint64_t> expect;
+		for (; !model.empty() && model.begin()->first <= target; model.erase(model.begin())) expect.push_back(model.begin()->second);
+		REQUIRE(out.size() == expect.size());
+		for (std::size_t i = 1; i < out.size(); ++i) REQUIRE(expiry[out[i - 1]] <= expiry[out[i]]);
+		std::sort(out.begin(), out.end());
+		std::sort(expect.begin(), expect.end());
+		REQUIRE(out == expect);
+		REQUIRE(w.size() == model.size());
+	}
+	out.clear();
+	w.advance_ticks(UINT64_MAX, out);
+	REQUIRE(out.size() == model.size());
+	REQUIRE(w.empty());
+}
+
+/**
+ * @test Verifies that stale handles cannot cancel a reused slab entry.
+ */
+TEST_CASE("kj::TimingWheel stale handles", "[timing_wheel]") {
+	kj::TimingWheel<std::string> w;
+	std::vector<std::string> out;
+	const auto a = w.schedule_in_ticks(10, "a");
+	REQUIRE(w.cancel(a));
+	REQUIRE_FALSE(w.cancel(a));
+	const auto b = w.schedule_in_ticks(1, "b");   // reuses a's entry
+	REQUIRE(b.index == a.index);
+	REQUIRE_FALSE(w.cancel(a));
+	REQUIRE(w.pending(b));
+	w.advance_ticks(1, out);
+	REQUIRE(out == std::vector<std::string>{ "b" });
+	REQUIRE_FALSE(w.cancel(b));
+	REQUIRE_FALSE(w.cancel(kj::TimerHandle{}));
+}
+
+namespace {
+	// Copy/move construction throws once a global budget is used up.
+	struct Fragile {
+		static inline int budget = -1;
+		int v = 0;
+		Fragile() = default;
+		explicit Fragile(int x) : v(x) {}
+		Fragile(const Fragile& o) : v(o.v) { spend(); }
+		Fragile(Fragile&& o) : v(o.v) { spend(); }
+		Fragile& operator=(const Fragile&) = default;
+		Fragile& operator=(Fragile&&) = default;
+		static void spend() { if (budget >= 0 && budget-- == 0) throw std::runtime_error("copy"); }
+	};
+}
+
+/**
+ * @test Verifies that a throwing append during advance keeps the remaining timers pending.
+ */
+TEST_CASE("kj::TimingWheel advance is exception safe", "[timing_wheel]") {
+	kj::TimingWheel<Fragile> w;
+	for (int i = 0; i < 10; ++i) w.schedule_in_ticks(1, Fragile(i));
+	w.schedule_in_ticks(200, Fragile(99));   // needs a cascade first
+	std::vector<Fragile> out;
+	out.reserve(64);
+
+	Fragile::budget = 3;
+	bool threw = false;
+	try { w.advance_ticks(1, out); }
+	catch (const std::runtime_error&) { threw = true; }
+	Fragile::budget = -1;
+	REQUIRE(threw);
+	REQUIRE(out.size() == 3);
+	REQUIRE(w.size() == 8);
+
+	REQUIRE(w.advance_ticks(0, out) == 7);
+	int sum = 0;
+	for (const auto& f : out) sum += f.v;
+	REQUIRE(sum == 45);
+	REQUIRE(w.advance_ticks(1000, out) == 1);
+	REQUIRE(out.back().v == 99);
+	REQUIRE(w.empty());
+}
+
+/**
+ * @test Verifies time-based scheduling and advancing with an explicit origin.
+ */
+TEST_CASE("kj::TimingWheel clock", "[timing_wheel]") {
+	using namespace std::chrono_literals;
+	const auto t0 = kj::Timer::clock::now();
+	kj::TimingWheel<int> w(1ms, t0);
+	std::vector<int> out;
+	w.schedule_after(2500us, 1);          // rounds up to tick 3
+	w.schedule_at(t0 + 10ms, 2);
+	w.schedule_at(t0 - 5ms, 3);           // past: next advance
+	REQUIRE(w.advance(out, t0) == 1);
+	REQUIRE(out == std::vector<int>{ 3 });
+	REQUIRE(w.advance(out, t0 + 2999us) == 0);
+	REQUIRE(w.advance(out, t0 + 3ms) == 1);
+	REQUIRE(w.advance(out, t0 + 1h) == 1);
+	REQUIRE(out == std::vector<int>{ 3, 1, 2 });
+	REQUIRE(w.now_tick() == 3600 * 1000);
+}
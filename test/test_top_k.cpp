@@ -0,0 +1,73 @@
+/**
+ * @file test_top_k.cpp
+ * @brief Unit tests for kj::TopK<T, Comp, Strategy>.
+ *
+ * Verifies both strategies against a full sort, single and batched pushes,
+ * custom comparators, and edge cases (k = 0, fewer elements than k).
+ */
+
+#include <catch2/catch_all.hpp>
+#include <kj/top_k.hpp>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+
+namespace {
+	template <kj::TopKStrategy S>
+	void check_against_sort(std::size_t k) {
+		std::mt19937 rng(static_cast<unsigned>(k) + 3);
+		std::vector<float> v(20000);
+		for (auto& x : v) x = static_cast<float>(rng() % 5000) / 7.0f;
+
+		kj::TopK<float, std::greater<float>, S> single(k);
+		for (float x : v) single.push(x);
+		kj::TopK<float, std::greater<float>, S> batched(k);
+		batched.push_batch(std::span<const float>(v.data(), 1234));
+		batched.push_batch(std::span<const float>(v.data() + 1234, v.size() - 1234));
+
+		std::vector<float> want = v;
+		std::sort(want.begin(), want.end(), std::greater<float>{});
+		want.resize(std::min(k, want.size()));
+		REQUIRE(single.size() == want.size());
+		REQUIRE(single.take_sorted() == want);
+		REQUIRE(batched.take_sorted() == want);
+		REQUIRE(single.empty());
+	}
+}
+
+/**
+ * @test Verifies both strategies against std::sort for several k.
+ */
+TEST_CASE("kj::TopK matches a full sort", "[top_k][model]") {
+	for (std::size_t k : {1u, 7u, 100u, 1000u}) {
+		check_against_sort<kj::TopKStrategy::heap>(k);
+		check_against_sort<kj::TopKStrategy::buffer>(k);
+	}
+}
+
+/**
+ * @test Verifies the default (k smallest), generic comparators and edge cases.
+ */
+TEST_CASE("kj::TopK basics", "[top_k][basic]") {
+	kj::TopK<int> small(3);
+	REQUIRE(small.capacity() == 3);
+	for (int x : {9, 4, 7, 1, 8}) small.push(x);
+	REQUIRE_FALSE(small.push(100));      // rejected by the threshold (7)
+	REQUIRE(small.push(2));
+	REQUIRE(small.take_sorted() == std::vector<int>({ 1, 2, 4 }));
+
+	kj::TopK<int, std::less<int>, kj::TopKStrategy::buffer> few(10);
+	few.push(3); few.push(1);
+	REQUIRE(few.take_sorted() == std::vector<int>({ 1, 3 }));
+
+	kj::TopK<int> none(0);
+	REQUIRE_FALSE(none.push(1));
+	REQUIRE(none.take_sorted().empty());
+
+	auto by_len = [](const std::string& a, const std::string& b) { return a.size() > b.size(); };
+	kj::TopK<std::string, decltype(by_len)> longest(2, by_len);
+	for (const char* s : { "a", "abcd", "ab", "abcdef", "abc" }) longest.push(s);
+	REQUIRE(longest.take_sorted() == std::vector<std::string>({ "abcdef", "abcd" }));
+}